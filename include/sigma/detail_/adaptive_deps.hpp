@@ -0,0 +1,529 @@
+#pragma once
+#include "sigma/detail_/deps_map.hpp"
+#include "sigma/memory_resource.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file adaptive_deps.hpp
+ *  @brief Defines the AdaptiveDeps class
+ */
+
+namespace sigma::detail_ {
+
+/** @brief Dependency storage switching between sparse and dense layouts.
+ *
+ *  Starts out as a sorted DepsMap. Once there are at least min_dense_size
+ *  dependencies and they fill at least dense_fill of the range of keys they
+ *  span, the derivatives are moved to a dense array indexed by key, starting
+ *  at the smallest key. Merging into a dense array is then a scatter of the
+ *  sparse entries or a single loop over two dense arrays, with no key
+ *  comparisons. If cancellations bring the fill below sparse_fill, the
+ *  storage goes back to the sparse layout. Since sources are numbered in
+ *  creation order, values depending on most of a stretch of sources, such as
+ *  the late stages of long computations, end up dense.
+ *
+ *  Like DepsMap, the dense array is copy-on-write, is allocated from the
+ *  calling thread's memory resource and carries a common scale factor.
+ *
+ *  @tparam KeyType The integral type identifying a dependency
+ *  @tparam ValueType The type of the partial derivatives
+ *
+ */
+template<typename KeyType, typename ValueType>
+class AdaptiveDeps {
+    static_assert(std::is_integral_v<KeyType>,
+                  "Dense storage needs integral keys");
+
+public:
+    /// Type of the instance
+    using my_t = AdaptiveDeps<KeyType, ValueType>;
+
+    /// The type identifying a dependency
+    using key_type = KeyType;
+
+    /// The type of the partial derivatives
+    using mapped_type = ValueType;
+
+    /// The type of the (key, derivative) pairs
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The type of the sparse storage
+    using sparse_t = DepsMap<key_type, mapped_type>;
+
+    /// The type used for sizes
+    using size_type = std::size_t;
+
+    /// The smallest number of dependencies stored densely
+    static constexpr size_type min_dense_size = 32;
+
+    /// The fraction of the key range that must be filled to become dense
+    static constexpr double dense_fill = 0.5;
+
+    /// The fraction of the key range below which dense storage goes sparse
+    static constexpr double sparse_fill = 0.125;
+
+    /** @brief Read-only iterator over the (key, derivative) pairs
+     *
+     *  Dereferencing yields the pairs by value, with the scale factor
+     *  already applied to the derivative. Zeros of the dense layout are
+     *  skipped.
+     */
+    class const_iterator {
+    public:
+        /// The iterator category
+        using iterator_category = std::forward_iterator_tag;
+
+        /// The type of the pairs
+        using value_type = typename my_t::value_type;
+
+        /// The type of the distance between iterators
+        using difference_type = std::ptrdiff_t;
+
+        /// Dereferencing yields a temporary pair
+        using reference = value_type;
+
+        /// Member access goes through a temporary pair
+        using pointer = typename sparse_t::const_iterator::pointer;
+
+        /// @brief Default ctor
+        const_iterator() noexcept = default;
+
+        /** @brief Construct an iterator over the sparse layout
+         *
+         *  @param entry The sparse iterator to wrap
+         *
+         *  @throw none No throw guarantee
+         */
+        explicit const_iterator(
+          typename sparse_t::const_iterator entry) noexcept :
+          m_sparse_(entry) {}
+
+        /** @brief Construct an iterator over the dense layout
+         *
+         *  @param derivs The dense derivatives
+         *  @param base The key of the first derivative
+         *  @param index The first index that may be pointed to
+         *  @param end The number of derivatives
+         *  @param scale The scale factor of the derivatives
+         *
+         *  @throw none No throw guarantee
+         */
+        const_iterator(const mapped_type* derivs, key_type base,
+                       size_type index, size_type end,
+                       mapped_type scale) noexcept :
+          m_derivs_(derivs),
+          m_base_(base),
+          m_index_(index),
+          m_end_(end),
+          m_scale_(scale) {
+            skip_zeros_();
+        }
+
+        /// @brief The pair pointed to
+        reference operator*() const {
+            if(m_derivs_ == nullptr) return *m_sparse_;
+            return value_type{static_cast<key_type>(m_base_ + m_index_),
+                              m_scale_ * m_derivs_[m_index_]};
+        }
+
+        /// @brief Access a member of the pair pointed to
+        pointer operator->() const { return pointer{**this}; }
+
+        /// @brief Advance to the next pair
+        const_iterator& operator++() noexcept {
+            if(m_derivs_ == nullptr) {
+                ++m_sparse_;
+            } else {
+                ++m_index_;
+                skip_zeros_();
+            }
+            return *this;
+        }
+
+        /// @brief Advance to the next pair
+        const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        /// @brief Whether two iterators point to the same pair
+        friend bool operator==(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            if(lhs.m_derivs_ == nullptr) return lhs.m_sparse_ == rhs.m_sparse_;
+            return lhs.m_derivs_ == rhs.m_derivs_ &&
+                   lhs.m_index_ == rhs.m_index_;
+        }
+
+        /// @brief Whether two iterators point to different pairs
+        friend bool operator!=(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        /// Move forward to the first non-zero derivative, or the end
+        void skip_zeros_() noexcept {
+            while(m_index_ < m_end_ && m_derivs_[m_index_] == mapped_type{0.0})
+                ++m_index_;
+        }
+
+        /// The position in the sparse layout
+        typename sparse_t::const_iterator m_sparse_;
+
+        /// The dense derivatives, null for the sparse layout
+        const mapped_type* m_derivs_ = nullptr;
+
+        /// The key of the first dense derivative
+        key_type m_base_ = 0;
+
+        /// The position in the dense layout
+        size_type m_index_ = 0;
+
+        /// The number of dense derivatives
+        size_type m_end_ = 0;
+
+        /// The scale factor of the dense derivatives
+        mapped_type m_scale_ = 1.0;
+    };
+
+    /// @brief Default ctor
+    AdaptiveDeps() noexcept = default;
+
+    /** @brief Construct storage holding a single dependency
+     *
+     *  @param key The dependency
+     *  @param deriv The partial derivative with respect to @p key
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    AdaptiveDeps(key_type key, mapped_type deriv) : m_sparse_(key, deriv) {}
+
+    /// @brief Whether the derivatives are stored densely
+    bool is_dense() const noexcept { return m_dense_ != nullptr; }
+
+    /// @brief Iterator to the first (key, derivative) pair
+    const_iterator begin() const noexcept {
+        if(!is_dense()) return const_iterator(m_sparse_.begin());
+        return {m_dense_->m_derivs.data(), m_dense_->m_base, 0, span_(),
+                m_scale_};
+    }
+
+    /// @brief Iterator just past the last (key, derivative) pair
+    const_iterator end() const noexcept {
+        if(!is_dense()) return const_iterator(m_sparse_.end());
+        return {m_dense_->m_derivs.data(), m_dense_->m_base, span_(), span_(),
+                m_scale_};
+    }
+
+    /// @brief The number of dependencies
+    size_type size() const noexcept {
+        return is_dense() ? m_dense_->m_nonzero : m_sparse_.size();
+    }
+
+    /// @brief Whether there are no dependencies
+    bool empty() const noexcept { return size() == 0; }
+
+    /** @brief Find the entry for a dependency
+     *
+     *  @param key The dependency to look for
+     *
+     *  @return An iterator to the entry for @p key, or end() if there is none
+     *
+     *  @throw none No throw guarantee
+     */
+    const_iterator find(const key_type& key) const {
+        if(!is_dense()) return const_iterator(m_sparse_.find(key));
+        if(key < m_dense_->m_base) return end();
+        auto index = static_cast<size_type>(key - m_dense_->m_base);
+        if(index >= span_() || m_dense_->m_derivs[index] == mapped_type{0.0})
+            return end();
+        return {m_dense_->m_derivs.data(), m_dense_->m_base, index, span_(),
+                m_scale_};
+    }
+
+    /** @brief Count the entries for a dependency
+     *
+     *  @param key The dependency to look for
+     *
+     *  @return 1 if there is an entry for @p key, 0 otherwise
+     *
+     *  @throw none No throw guarantee
+     */
+    size_type count(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    /** @brief Multiply every derivative by a factor
+     *
+     *  Constant time in both layouts. Scaling by zero removes all of the
+     *  entries.
+     *
+     *  @param factor The value the derivatives are multiplied by
+     *
+     *  @throw none No throw guarantee
+     */
+    void scale(mapped_type factor) noexcept {
+        if(!is_dense()) {
+            m_sparse_.scale(factor);
+        } else if(factor == mapped_type{0.0}) {
+            clear_();
+        } else {
+            m_scale_ *= factor;
+        }
+    }
+
+    /** @brief Add a scaled set of dependencies to this one
+     *
+     *  Performs `*this += factor * other`, whatever the layouts of the two
+     *  sets. Entries of the result whose derivative is zero are dropped.
+     *  @p other may be this instance. The layout of the result is chosen
+     *  from its fill, which is bounded from the sizes and key ranges of the
+     *  two sets before any dense block is allocated.
+     *
+     *  @param other The dependencies to add
+     *  @param factor The value the derivatives of @p other are multiplied by
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    void merge(const my_t& other, mapped_type factor) {
+        if(other.empty() || factor == mapped_type{0.0}) return;
+        if(empty()) {
+            *this = other;
+            scale(factor);
+            return;
+        }
+        if(!is_dense() && !other.is_dense()) {
+            m_sparse_.merge(other.m_sparse_, factor);
+            if(should_densify_()) densify_();
+            return;
+        }
+        if(&other == this) {
+            scale(mapped_type{1.0} + factor);
+            return;
+        }
+
+        // Check the fill before allocating a block for the combined range,
+        // so a single distant key cannot blow the block up
+        auto [first, last]             = key_range_(*this);
+        auto [other_first, other_last] = key_range_(other);
+        first = std::min(first, other_first);
+        last  = std::max(last, other_last);
+        auto span = static_cast<double>(last - first) + 1.0;
+        if(static_cast<double>(size() + other.size()) < sparse_fill * span) {
+            merge_sparse_(other, factor);
+            return;
+        }
+
+        auto rhs_factor = factor * other.m_scale_;
+        if(!is_dense()) {
+            // Start from a dense copy of other and scatter this one into it
+            auto block      = make_block_(first, last);
+            auto& dst       = block->m_derivs;
+            const auto& src = other.m_dense_->m_derivs;
+            auto off = static_cast<size_type>(other.m_dense_->m_base - first);
+            for(size_type i = 0; i < src.size(); ++i) {
+                dst[off + i] = rhs_factor * src[i];
+            }
+            block->m_nonzero = other.m_dense_->m_nonzero;
+            for(const auto& [key, deriv] : m_sparse_) add_(*block, key, deriv);
+            m_sparse_ = sparse_t{};
+            m_dense_  = std::move(block);
+            m_scale_  = mapped_type{1.0};
+        } else {
+            reserve_range_(first, last);
+            auto& block = *m_dense_;
+            if(other.is_dense()) {
+                const auto& src = other.m_dense_->m_derivs;
+                auto key        = other.m_dense_->m_base;
+                for(size_type i = 0; i < src.size(); ++i, ++key) {
+                    if(src[i] != mapped_type{0.0})
+                        add_(block, key, rhs_factor * src[i]);
+                }
+            } else {
+                for(const auto& [key, deriv] : other.m_sparse_) {
+                    add_(block, key, factor * deriv);
+                }
+            }
+        }
+        if(m_dense_->m_nonzero == 0) {
+            clear_();
+        } else if(m_dense_->m_nonzero < sparse_fill * span_()) {
+            sparsify_();
+        }
+    }
+
+    /** @brief Remove the entries whose derivative is zero
+     *
+     *  Zeros of the dense layout are never reported, so only the sparse
+     *  layout has anything to do.
+     *
+     *  @throw std::bad_alloc if the sparse storage is shared and copying it
+     *         fails. Strong throw guarantee.
+     */
+    void prune() {
+        if(!is_dense()) m_sparse_.prune();
+    }
+
+    /** @brief Compare two sets of dependencies for equality
+     *
+     *  @param rhs The set to compare against
+     *
+     *  @return Whether both hold the same (key, derivative) pairs, whatever
+     *          their layouts
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator==(const my_t& rhs) const {
+        if(size() != rhs.size()) return false;
+        if(!is_dense() && !rhs.is_dense()) return m_sparse_ == rhs.m_sparse_;
+        return std::equal(begin(), end(), rhs.begin(), rhs.end());
+    }
+
+    /** @brief Compare two sets of dependencies for inequality
+     *
+     *  @param rhs The set to compare against
+     *
+     *  @return Whether the sets hold different (key, derivative) pairs
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator!=(const my_t& rhs) const { return !(*this == rhs); }
+
+private:
+    /// The type of the allocator for the dense derivatives
+    using allocator_type = std::pmr::polymorphic_allocator<mapped_type>;
+
+    /// The dense derivatives, starting at the key m_base
+    struct DenseBlock {
+        /// The key of the first derivative
+        key_type m_base;
+
+        /// The derivatives, zero for keys that are not dependencies
+        std::vector<mapped_type, allocator_type> m_derivs;
+
+        /// The number of non-zero derivatives
+        size_type m_nonzero;
+    };
+
+    /// The number of dense derivatives
+    size_type span_() const noexcept { return m_dense_->m_derivs.size(); }
+
+    /// Whether the sparse layout is now full enough to go dense
+    bool should_densify_() const {
+        auto n = m_sparse_.size();
+        if(n < min_dense_size) return false;
+        auto first = m_sparse_.begin()->first;
+        auto last  = std::prev(m_sparse_.end())->first;
+        return n >= dense_fill * (static_cast<double>(last - first) + 1.0);
+    }
+
+    /// The smallest and largest keys that may be stored by @p deps
+    static std::pair<key_type, key_type> key_range_(const my_t& deps) {
+        if(!deps.is_dense()) {
+            return {deps.m_sparse_.begin()->first,
+                    std::prev(deps.m_sparse_.end())->first};
+        }
+        auto base = deps.m_dense_->m_base;
+        return {base, static_cast<key_type>(base + deps.span_() - 1)};
+    }
+
+    /// Allocate a zeroed dense block for the keys first to last
+    static std::shared_ptr<DenseBlock> make_block_(key_type first,
+                                                   key_type last) {
+        allocator_type alloc(sigma::get_memory_resource());
+        auto span = static_cast<size_type>(last - first) + 1;
+        return std::allocate_shared<DenseBlock>(
+          alloc, DenseBlock{first,
+                            std::vector<mapped_type, allocator_type>(
+                              span, mapped_type{0.0}, alloc),
+                            0});
+    }
+
+    /// Add @p deriv to the dense derivative of @p key, tracking the fill
+    static void add_(DenseBlock& block, key_type key, mapped_type deriv) {
+        auto index    = static_cast<size_type>(key - block.m_base);
+        auto& value   = block.m_derivs[index];
+        auto was_zero = value == mapped_type{0.0};
+        value += deriv;
+        auto is_zero = value == mapped_type{0.0};
+        if(was_zero && !is_zero) ++block.m_nonzero;
+        if(!was_zero && is_zero) --block.m_nonzero;
+    }
+
+    /** Make the dense block unshared, unscaled and large enough for the keys
+     *  first to last
+     */
+    void reserve_range_(key_type first, key_type last) {
+        auto base     = m_dense_->m_base;
+        auto old_last = static_cast<key_type>(base + span_() - 1);
+        bool fits     = first >= base && last <= old_last;
+        if(fits && m_dense_.use_count() == 1 && m_scale_ == mapped_type{1.0})
+            return;
+        auto block =
+          make_block_(std::min(first, base), std::max(last, old_last));
+        auto off        = static_cast<size_type>(base - block->m_base);
+        const auto& src = m_dense_->m_derivs;
+        auto& dst       = block->m_derivs;
+        for(size_type i = 0; i < src.size(); ++i) {
+            dst[off + i] = m_scale_ * src[i];
+            if(dst[off + i] != mapped_type{0.0}) ++block->m_nonzero;
+        }
+        m_dense_ = std::move(block);
+        m_scale_ = mapped_type{1.0};
+    }
+
+    /// Merge through the sparse layout, for results too spread out for dense
+    void merge_sparse_(const my_t& other, mapped_type factor) {
+        auto sparse = is_dense() ? sparse_t(begin(), end()) : m_sparse_;
+        if(other.is_dense()) {
+            sparse.merge(sparse_t(other.begin(), other.end()), factor);
+        } else {
+            sparse.merge(other.m_sparse_, factor);
+        }
+        clear_();
+        m_sparse_ = std::move(sparse);
+        if(should_densify_()) densify_();
+    }
+
+    /// Move the sparse derivatives to a dense block
+    void densify_() {
+        auto block = make_block_(m_sparse_.begin()->first,
+                                 std::prev(m_sparse_.end())->first);
+        for(const auto& [key, deriv] : m_sparse_) add_(*block, key, deriv);
+        m_sparse_ = sparse_t{};
+        m_dense_  = std::move(block);
+        m_scale_  = mapped_type{1.0};
+    }
+
+    /// Move the dense derivatives back to sparse storage
+    void sparsify_() {
+        sparse_t sparse(begin(), end());
+        clear_();
+        m_sparse_ = std::move(sparse);
+    }
+
+    /// Remove all of the dependencies
+    void clear_() noexcept {
+        m_sparse_ = sparse_t{};
+        m_dense_.reset();
+        m_scale_ = mapped_type{1.0};
+    }
+
+    /// The dependencies, while they are stored sparsely
+    sparse_t m_sparse_ = {};
+
+    /// The dependencies, once they are stored densely
+    std::shared_ptr<DenseBlock> m_dense_ = {};
+
+    /// The factor applied to all of the dense derivatives
+    mapped_type m_scale_ = 1.0;
+};
+
+} // namespace sigma::detail_
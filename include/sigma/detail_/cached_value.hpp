@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+/** @file cached_value.hpp
+ *  @brief Defines the CachedValue class
+ */
+
+namespace sigma::detail_ {
+
+/** @brief A lazily computed value that can be refreshed through const access.
+ *
+ *  Holds a value together with the stamp of the state it was computed from.
+ *  The value is up to date while the owner asks for the same stamp, so
+ *  bumping a stamp shared by many owners, e.g. a generation counter,
+ *  invalidates all of their caches at once. Owners without such a counter
+ *  use the default stamp. The cache may be filled from const member
+ *  functions of the owning class, so both parts are atomics; concurrent
+ *  readers of the same owner may each compute and store the value, but
+ *  always store the same result. Copies take a snapshot of the cache.
+ *
+ *  @tparam ValueType The type of the cached value
+ *
+ */
+template<typename ValueType>
+class CachedValue {
+public:
+    /// Type of the instance
+    using my_t = CachedValue<ValueType>;
+
+    /// The type of the cached value
+    using value_t = ValueType;
+
+    /// The type of the stamps
+    using stamp_t = std::uint32_t;
+
+    /// The stamp of a value that is out of date
+    static constexpr stamp_t invalid_stamp = 0;
+
+    /// The stamp used by owners that only ever invalidate the cache
+    static constexpr stamp_t default_stamp = 1;
+
+    /** @brief Construct a cache holding a valid value
+     *
+     *  @param value The initial value
+     *  @param stamp The stamp @p value is valid for
+     *
+     *  @throw none No throw guarantee
+     */
+    CachedValue(value_t value = value_t{},
+                stamp_t stamp = default_stamp) noexcept :
+      m_value_(value), m_stamp_(stamp) {}
+
+    /// @brief Copy ctor
+    CachedValue(const my_t& other) noexcept { copy_(other); }
+
+    /// @brief Copy assignment
+    my_t& operator=(const my_t& rhs) noexcept {
+        if(this != &rhs) copy_(rhs);
+        return *this;
+    }
+
+    /** @brief Whether the cached value is up to date
+     *
+     *  @param stamp The current stamp
+     *
+     *  @throw none No throw guarantee
+     */
+    bool valid(stamp_t stamp = default_stamp) const noexcept {
+        return m_stamp_.load(std::memory_order_acquire) == stamp;
+    }
+
+    /** @brief The cached value, meaningful only if valid()
+     *
+     *  @throw none No throw guarantee
+     */
+    value_t get() const noexcept {
+        return m_value_.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Store an up to date value
+     *
+     *  @param value The value to cache
+     *  @param stamp The current stamp
+     *
+     *  @throw none No throw guarantee
+     */
+    void set(value_t value, stamp_t stamp = default_stamp) const noexcept {
+        m_value_.store(value, std::memory_order_relaxed);
+        m_stamp_.store(stamp, std::memory_order_release);
+    }
+
+    /** @brief Mark the cached value as out of date
+     *
+     *  @throw none No throw guarantee
+     */
+    void invalidate() noexcept {
+        m_stamp_.store(invalid_stamp, std::memory_order_relaxed);
+    }
+
+    /** @brief Get the value, computing and caching it if it is out of date
+     *
+     *  @tparam FunctionType The type of @p compute
+     *  @param compute Callable returning the up to date value
+     *  @param stamp The current stamp
+     *
+     *  @return The up to date value
+     */
+    template<typename FunctionType>
+    value_t get_or_compute(FunctionType&& compute,
+                           stamp_t stamp = default_stamp) const {
+        if(valid(stamp)) return get();
+        value_t value = compute();
+        set(value, stamp);
+        return value;
+    }
+
+private:
+    /// Take a snapshot of another cache
+    void copy_(const my_t& other) noexcept {
+        auto stamp = other.m_stamp_.load(std::memory_order_acquire);
+        m_value_.store(other.get(), std::memory_order_relaxed);
+        m_stamp_.store(stamp, std::memory_order_release);
+    }
+
+    /// The cached value
+    mutable std::atomic<value_t> m_value_;
+
+    /// The stamp the cached value is valid for
+    mutable std::atomic<stamp_t> m_stamp_;
+};
+
+} // namespace sigma::detail_
@@ -0,0 +1,770 @@
+#pragma once
+#include "sigma/memory_resource.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file deps_map.hpp
+ *  @brief Defines the DepsMap class
+ */
+
+/** @def SIGMA_INLINE_DEPS
+ *  @brief The number of dependencies an Uncertain stores without allocating
+ *
+ *  Define this before including any sigma header to change the default.
+ */
+#ifndef SIGMA_INLINE_DEPS
+#define SIGMA_INLINE_DEPS 4
+#endif
+
+namespace sigma::detail_ {
+
+/** @brief Contiguous storage for the dependencies of an uncertain variable.
+ *
+ *  The dependencies are stored as (key, derivative) pairs in a single buffer
+ *  that is kept sorted by key. Lookups are binary searches and combining the
+ *  dependencies of two variables is a single linear merge of the two sorted
+ *  ranges, so no per-entry allocations or pointer-chasing are needed.
+ *
+ *  Up to @p InlineSize entries are held in a buffer inside the instance
+ *  itself; only larger sets of dependencies are spilled to the heap. Heap
+ *  storage is copy-on-write: copies of a map share the same block until one
+ *  of them is modified, so copying costs the same regardless of the number
+ *  of dependencies. Heap blocks are allocated from the memory resource of
+ *  the calling thread (see sigma::set_memory_resource()), so a computation
+ *  can keep all of its dependency storage in an arena of its own.
+ *
+ *  The stored derivatives share a common scale factor, so multiplying all
+ *  of them by a constant, as every unary operation does, only updates that
+ *  factor. Iterating over the map yields the scaled derivatives.
+ *
+ *  @tparam KeyType The type identifying a dependency
+ *  @tparam ValueType The type of the partial derivatives
+ *  @tparam InlineSize The number of entries stored without allocating
+ *
+ */
+template<typename KeyType, typename ValueType,
+         std::size_t InlineSize = SIGMA_INLINE_DEPS>
+class DepsMap {
+public:
+    /// Type of the instance
+    using my_t = DepsMap<KeyType, ValueType, InlineSize>;
+
+    /// The type identifying a dependency
+    using key_type = KeyType;
+
+    /// The type of the partial derivatives
+    using mapped_type = ValueType;
+
+    /// The type of the (key, derivative) pairs
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The type of the allocator for the heap storage
+    using allocator_type = std::pmr::polymorphic_allocator<value_type>;
+
+    /// The type of the heap storage
+    using container_t = std::vector<value_type, allocator_type>;
+
+    /// The type of a shared block of heap storage
+    using block_ptr = std::shared_ptr<container_t>;
+
+    /// The type used for sizes
+    using size_type = std::size_t;
+
+    /// The number of entries stored without allocating
+    static constexpr size_type inline_size = InlineSize;
+
+    /** @brief Read-only iterator over the (key, derivative) pairs
+     *
+     *  Dereferencing yields the pairs by value, with the scale factor of the
+     *  map already applied to the derivative.
+     */
+    class const_iterator {
+    public:
+        /// The iterator category
+        using iterator_category = std::random_access_iterator_tag;
+
+        /// The type of the pairs
+        using value_type = typename my_t::value_type;
+
+        /// The type of the distance between iterators
+        using difference_type = std::ptrdiff_t;
+
+        /// Dereferencing yields a temporary pair
+        using reference = value_type;
+
+        /// Member access goes through a temporary pair
+        struct pointer {
+            /// The pair being accessed
+            value_type m_pair;
+            /// Access the pair
+            const value_type* operator->() const { return &m_pair; }
+        };
+
+        /// @brief Default ctor
+        const_iterator() noexcept = default;
+
+        /** @brief Construct from a stored entry and the scale factor
+         *
+         *  @param entry The stored entry this iterator points to
+         *  @param scale The scale factor of the map
+         *
+         *  @throw none No throw guarantee
+         */
+        const_iterator(const value_type* entry, mapped_type scale) noexcept :
+          m_entry_(entry), m_scale_(scale) {}
+
+        /// @brief The pair pointed to
+        reference operator*() const {
+            return value_type{m_entry_->first, m_scale_ * m_entry_->second};
+        }
+
+        /// @brief Access a member of the pair pointed to
+        pointer operator->() const { return pointer{**this}; }
+
+        /// @brief The pair @p n entries away
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        /// @brief Pre-increment
+        const_iterator& operator++() noexcept {
+            ++m_entry_;
+            return *this;
+        }
+
+        /// @brief Post-increment
+        const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++m_entry_;
+            return copy;
+        }
+
+        /// @brief Pre-decrement
+        const_iterator& operator--() noexcept {
+            --m_entry_;
+            return *this;
+        }
+
+        /// @brief Post-decrement
+        const_iterator operator--(int) noexcept {
+            auto copy = *this;
+            --m_entry_;
+            return copy;
+        }
+
+        /// @brief Advance by @p n entries
+        const_iterator& operator+=(difference_type n) noexcept {
+            m_entry_ += n;
+            return *this;
+        }
+
+        /// @brief Go back by @p n entries
+        const_iterator& operator-=(difference_type n) noexcept {
+            m_entry_ -= n;
+            return *this;
+        }
+
+        /// @brief An iterator @p n entries ahead
+        friend const_iterator operator+(const_iterator itr, difference_type n) {
+            return itr += n;
+        }
+
+        /// @brief An iterator @p n entries ahead
+        friend const_iterator operator+(difference_type n, const_iterator itr) {
+            return itr += n;
+        }
+
+        /// @brief An iterator @p n entries back
+        friend const_iterator operator-(const_iterator itr, difference_type n) {
+            return itr -= n;
+        }
+
+        /// @brief The number of entries between two iterators
+        friend difference_type operator-(const const_iterator& lhs,
+                                         const const_iterator& rhs) {
+            return lhs.m_entry_ - rhs.m_entry_;
+        }
+
+        /// @brief Whether two iterators point to the same entry
+        friend bool operator==(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return lhs.m_entry_ == rhs.m_entry_;
+        }
+
+        /// @brief Whether two iterators point to different entries
+        friend bool operator!=(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+        /// @brief Whether @p lhs points to an earlier entry than @p rhs
+        friend bool operator<(const const_iterator& lhs,
+                              const const_iterator& rhs) {
+            return lhs.m_entry_ < rhs.m_entry_;
+        }
+
+        /// @brief Whether @p lhs points to a later entry than @p rhs
+        friend bool operator>(const const_iterator& lhs,
+                              const const_iterator& rhs) {
+            return rhs < lhs;
+        }
+
+        /// @brief Whether @p lhs does not point to a later entry than @p rhs
+        friend bool operator<=(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return !(rhs < lhs);
+        }
+
+        /// @brief Whether @p lhs does not point to an earlier entry than @p rhs
+        friend bool operator>=(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return !(lhs < rhs);
+        }
+
+    private:
+        /// The stored entry
+        const value_type* m_entry_ = nullptr;
+
+        /// The scale factor of the map
+        mapped_type m_scale_ = 1.0;
+    };
+
+    /// @brief Default ctor
+    DepsMap() noexcept = default;
+
+    /** @brief Construct a map holding a single dependency
+     *
+     *  @param key The dependency
+     *  @param deriv The partial derivative with respect to @p key
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    DepsMap(key_type key, mapped_type deriv) {
+        append_(value_type{std::move(key), deriv});
+    }
+
+    /** @brief Construct a map from a range of (key, derivative) pairs
+     *
+     *  The pairs must be sorted by key, with unique keys and no zero
+     *  derivatives.
+     *
+     *  @tparam InputIterator The type of the iterators over the pairs
+     *  @param first The first pair
+     *  @param last Just past the last pair
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    template<typename InputIterator>
+    DepsMap(InputIterator first, InputIterator last) {
+        for(; first != last; ++first) append_(*first);
+    }
+
+    /// @brief Copy ctor
+    DepsMap(const my_t& other) = default;
+
+    /** @brief Move ctor
+     *
+     *  @param other The map to take the dependencies of. Left empty.
+     *
+     *  @throw none No throw guarantee
+     */
+    DepsMap(my_t&& other) noexcept :
+      m_size_(other.m_size_),
+      m_scale_(other.m_scale_),
+      m_inline_(other.m_inline_),
+      m_heap_(std::move(other.m_heap_)) {
+        other.m_size_ = 0;
+    }
+
+    /// @brief Copy assignment
+    my_t& operator=(const my_t& rhs) = default;
+
+    /** @brief Move assignment
+     *
+     *  @param rhs The map to take the dependencies of. Left empty.
+     *
+     *  @return This instance, holding the dependencies of @p rhs
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t& operator=(my_t&& rhs) noexcept {
+        if(this == &rhs) return *this;
+        m_size_     = rhs.m_size_;
+        m_scale_    = rhs.m_scale_;
+        m_inline_   = rhs.m_inline_;
+        m_heap_     = std::move(rhs.m_heap_);
+        rhs.m_size_ = 0;
+        return *this;
+    }
+
+    /// @brief Iterator to the first (key, derivative) pair
+    const_iterator begin() const noexcept { return {data_(), m_scale_}; }
+
+    /// @brief Iterator just past the last (key, derivative) pair
+    const_iterator end() const noexcept {
+        return {data_() + m_size_, m_scale_};
+    }
+
+    /// @brief The number of dependencies
+    size_type size() const noexcept { return m_size_; }
+
+    /// @brief Whether there are no dependencies
+    bool empty() const noexcept { return m_size_ == 0; }
+
+    /// @brief Whether the dependencies are stored inside the instance
+    bool is_inline() const noexcept { return m_size_ <= inline_size; }
+
+    /** @brief The heap block holding the dependencies
+     *
+     *  Maps sharing a block with the same scale factor hold the same
+     *  dependencies.
+     *
+     *  @return The block, or null if the dependencies are stored inline
+     *
+     *  @throw none No throw guarantee
+     */
+    const void* block() const noexcept {
+        return is_inline() ? nullptr : m_heap_.get();
+    }
+
+    /// @brief The factor applied to the stored derivatives
+    mapped_type scale_factor() const noexcept { return m_scale_; }
+
+    /** @brief Find the entry for a dependency
+     *
+     *  @param key The dependency to look for
+     *
+     *  @return An iterator to the entry for @p key, or end() if there is none
+     *
+     *  @throw none No throw guarantee
+     */
+    const_iterator find(const key_type& key) const {
+        auto* first = data_();
+        auto* last  = first + m_size_;
+        auto* entry = lower_bound_(first, last, key);
+        if(entry != last && !(key < entry->first)) return {entry, m_scale_};
+        return end();
+    }
+
+    /** @brief Count the entries for a dependency
+     *
+     *  @param key The dependency to look for
+     *
+     *  @return 1 if there is an entry for @p key, 0 otherwise
+     *
+     *  @throw none No throw guarantee
+     */
+    size_type count(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    /** @brief Multiply every derivative by a factor
+     *
+     *  The factor is accumulated into a scale factor for the whole map, so
+     *  this is a constant time operation; it is applied to the stored
+     *  derivatives when they are merged with those of another map. Scaling
+     *  by zero removes all of the entries.
+     *
+     *  @param factor The value the derivatives are multiplied by
+     *
+     *  @throw none No throw guarantee
+     */
+    void scale(mapped_type factor) noexcept {
+        if(factor == mapped_type{0.0}) {
+            m_size_  = 0;
+            m_scale_ = 1.0;
+            m_heap_.reset();
+            return;
+        }
+        m_scale_ *= factor;
+    }
+
+    /** @brief Add a scaled set of dependencies to this one
+     *
+     *  Performs `*this += factor * other` with a single linear merge of the
+     *  two sorted ranges. Entries present in both have their derivatives
+     *  summed; entries present in only one are carried over. Entries of the
+     *  result whose derivative is zero are dropped. @p other may be this
+     *  instance. The merge only allocates if the result does not fit in the
+     *  inline buffer.
+     *
+     *  If both sets of derivatives carry the same scale factor it is kept,
+     *  otherwise the factors are folded into the merged derivatives.
+     *
+     *  When this instance is the only owner of its heap storage and that
+     *  storage has room for the result, the merge is done in place, from the
+     *  back, without allocating. Entries of this instance that come before
+     *  all of @p other's and need no rescaling are not touched at all, so
+     *  accumulating newer sources into a temporary only costs the size of
+     *  the addition.
+     *
+     *  @param other The dependencies to add
+     *  @param factor The value the derivatives of @p other are multiplied by
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    void merge(const my_t& other, mapped_type factor) {
+        if(other.empty() || factor == mapped_type{0.0}) return;
+        if(empty()) {
+            *this = other;
+            m_scale_ *= factor;
+            return;
+        }
+
+        auto lhs_factor = m_scale_;
+        auto rhs_factor = factor * other.m_scale_;
+        auto new_scale  = mapped_type{1.0};
+        if(lhs_factor == rhs_factor) {
+            new_scale  = lhs_factor;
+            lhs_factor = rhs_factor = mapped_type{1.0};
+        }
+
+        auto total = size() + other.size();
+        if(total <= inline_size) {
+            std::array<value_type, inline_size> merged;
+            auto last = merge_(*this, lhs_factor, other, rhs_factor,
+                               merged.begin());
+            m_inline_ = merged;
+            m_size_   = static_cast<size_type>(last - merged.begin());
+        } else if(owns_heap_() && &other != this &&
+                  m_heap_->capacity() >= total) {
+            merge_in_place_(other, lhs_factor, rhs_factor);
+        } else {
+            // Only grow geometrically when this looks like an accumulator
+            auto capacity = total;
+            if(owns_heap_()) {
+                capacity = std::max(total, m_heap_->capacity() * 3 / 2);
+            }
+            container_t merged(allocator_());
+            merged.reserve(capacity);
+            merge_(*this, lhs_factor, other, rhs_factor,
+                   std::back_inserter(merged));
+            assign_(std::move(merged));
+        }
+        m_scale_ = new_scale;
+    }
+
+    /** @brief Form a linear combination of several maps
+     *
+     *  Computes `sum_i factor_i * map_i` with a single k-way merge of the
+     *  sorted maps, driven by a heap over their current entries. Unlike a
+     *  chain of pairwise merges, every entry is only visited once and the
+     *  result is written straight into its final storage. Entries whose
+     *  derivatives cancel are dropped.
+     *
+     *  @tparam InputIterator The type of the iterators over the terms
+     *  @param first The first term, a (pointer to map, factor) pair
+     *  @param last Just past the last term
+     *
+     *  @return The linear combination of the maps
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    template<typename InputIterator>
+    static my_t combine(InputIterator first, InputIterator last) {
+        struct cursor {
+            const value_type* pos;
+            const value_type* end;
+            mapped_type factor;
+        };
+        // Only combinations of very many terms need the heap for this
+        alignas(cursor) std::byte buffer[32 * sizeof(cursor)];
+        std::pmr::monotonic_buffer_resource arena(
+          buffer, sizeof(buffer), sigma::get_memory_resource());
+        std::pmr::vector<cursor> cursors(&arena);
+        cursors.reserve(32);
+        size_type total = 0;
+        for(; first != last; ++first) {
+            const my_t& map = *first->first;
+            auto factor     = mapped_type(first->second) * map.m_scale_;
+            if(map.empty() || factor == mapped_type{0.0}) continue;
+            const auto* data = map.data_();
+            cursors.push_back(cursor{data, data + map.m_size_, factor});
+            total += map.m_size_;
+        }
+
+        my_t result;
+        if(total <= inline_size) {
+            auto last_entry = combine_(cursors, result.m_inline_.begin());
+            result.m_size_ =
+              static_cast<size_type>(last_entry - result.m_inline_.begin());
+        } else {
+            container_t merged(allocator_());
+            merged.reserve(total);
+            combine_(cursors, std::back_inserter(merged));
+            result.assign_(std::move(merged));
+        }
+        return result;
+    }
+
+    /** @brief Remove the entries whose derivative is zero
+     *
+     *  @throw std::bad_alloc if the storage is shared and copying it fails.
+     *         Strong throw guarantee.
+     */
+    void prune() {
+        auto is_zero = [](const value_type& entry) {
+            return entry.second == mapped_type{0.0};
+        };
+        auto* first = data_();
+        if(std::none_of(first, first + m_size_, is_zero)) return;
+        if(!is_inline()) make_unique_();
+        first      = data_();
+        auto* last = std::remove_if(first, first + m_size_, is_zero);
+        auto count = static_cast<size_type>(last - first);
+        if(!is_inline() && count <= inline_size) {
+            std::copy(first, last, m_inline_.begin());
+            m_heap_.reset();
+        } else if(!is_inline()) {
+            m_heap_->resize(count);
+        }
+        m_size_ = count;
+    }
+
+    /** @brief Compare two maps for equality
+     *
+     *  @param rhs The map to compare against
+     *
+     *  @return Whether both maps hold the same (key, derivative) pairs
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator==(const my_t& rhs) const {
+        if(size() != rhs.size()) return false;
+        if(!is_inline() && m_heap_ == rhs.m_heap_ && m_scale_ == rhs.m_scale_)
+            return true;
+        return std::equal(begin(), end(), rhs.begin());
+    }
+
+    /** @brief Compare two maps for inequality
+     *
+     *  @param rhs The map to compare against
+     *
+     *  @return Whether the maps hold different (key, derivative) pairs
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator!=(const my_t& rhs) const { return !(*this == rhs); }
+
+private:
+    /// The buffer currently holding the entries
+    value_type* data_() noexcept {
+        return is_inline() ? m_inline_.data() : m_heap_->data();
+    }
+
+    /// The buffer currently holding the entries
+    const value_type* data_() const noexcept {
+        return is_inline() ? m_inline_.data() : m_heap_->data();
+    }
+
+    /// Allocator drawing from the calling thread's memory resource
+    static allocator_type allocator_() noexcept {
+        return allocator_type(sigma::get_memory_resource());
+    }
+
+    /// Allocate a heap block, constructing its storage from @p args
+    template<typename... Args>
+    static block_ptr make_block_(Args&&... args) {
+        // The allocator is also handed to the container by uses-allocator
+        // construction, so block and entries come from the same resource
+        return std::allocate_shared<container_t>(allocator_(),
+                                                 std::forward<Args>(args)...);
+    }
+
+    /// Whether the entries are on the heap and no other instance shares them
+    bool owns_heap_() const noexcept {
+        return !is_inline() && m_heap_.use_count() == 1;
+    }
+
+    /// Give this instance its own copy of the heap block, if it is shared
+    void make_unique_() {
+        if(m_heap_.use_count() != 1) {
+            m_heap_ = make_block_(*m_heap_);
+        }
+    }
+
+    /// Add an entry with a key larger than all present
+    void append_(value_type entry) {
+        if(m_size_ < inline_size) {
+            m_inline_[m_size_] = std::move(entry);
+        } else {
+            if(m_size_ == inline_size) {
+                m_heap_ = make_block_(m_inline_.begin(), m_inline_.end());
+            } else {
+                make_unique_();
+            }
+            m_heap_->push_back(std::move(entry));
+        }
+        ++m_size_;
+    }
+
+    /// Take ownership of a sorted set of entries
+    void assign_(container_t&& entries) {
+        m_size_ = entries.size();
+        if(is_inline()) {
+            std::copy(entries.begin(), entries.end(), m_inline_.begin());
+            m_heap_.reset();
+        } else {
+            m_heap_ = make_block_(std::move(entries));
+        }
+    }
+
+    /// Write the stored entries of `lf * lhs + rf * rhs` to @p out
+    template<typename OutputIterator>
+    static OutputIterator merge_(const my_t& lhs, mapped_type lf,
+                                 const my_t& rhs, mapped_type rf,
+                                 OutputIterator out) {
+        const auto *l = lhs.data_(), *l_end = l + lhs.m_size_;
+        const auto *r = rhs.data_(), *r_end = r + rhs.m_size_;
+        auto emit = [&out](const key_type& key, mapped_type deriv) {
+            if(deriv != mapped_type{0.0}) *out++ = value_type{key, deriv};
+        };
+        while(l != l_end && r != r_end) {
+            if(l->first < r->first) {
+                emit(l->first, lf * l->second);
+                ++l;
+            } else if(r->first < l->first) {
+                emit(r->first, rf * r->second);
+                ++r;
+            } else {
+                emit(l->first, lf * l->second + rf * r->second);
+                ++l;
+                ++r;
+            }
+        }
+        for(; l != l_end; ++l) emit(l->first, lf * l->second);
+        for(; r != r_end; ++r) emit(r->first, rf * r->second);
+        return out;
+    }
+
+    /// Write the non-zero entries of the sum over @p cursors to @p out
+    template<typename Cursors, typename OutputIterator>
+    static OutputIterator combine_(Cursors& cursors, OutputIterator out) {
+        using cursor = typename Cursors::value_type;
+        auto later = [](const cursor& lhs, const cursor& rhs) {
+            return rhs.pos->first < lhs.pos->first;
+        };
+        // Takes the next entry off the cursor with the smallest key
+        auto pop = [&cursors, &later]() {
+            std::pop_heap(cursors.begin(), cursors.end(), later);
+            auto& next = cursors.back();
+            auto entry =
+              value_type{next.pos->first, next.factor * next.pos->second};
+            if(++next.pos == next.end) {
+                cursors.pop_back();
+            } else {
+                std::push_heap(cursors.begin(), cursors.end(), later);
+            }
+            return entry;
+        };
+
+        std::make_heap(cursors.begin(), cursors.end(), later);
+        while(!cursors.empty()) {
+            auto entry = pop();
+            while(!cursors.empty() &&
+                  !(entry.first < cursors.front().pos->first)) {
+                entry.second += pop().second;
+            }
+            if(entry.second != mapped_type{0.0}) *out++ = entry;
+        }
+        return out;
+    }
+
+    /// Merge `lf * this + rf * rhs` into the heap block, from the back
+    void merge_in_place_(const my_t& rhs, mapped_type lf, mapped_type rf) {
+        auto& heap   = *m_heap_;
+        auto l       = heap.size();
+        auto r       = rhs.size();
+        auto total   = l + r;
+        const auto* rhs_data = rhs.data_();
+        heap.resize(total);
+        auto* data = heap.data();
+
+        auto w        = total;
+        bool has_zero = false;
+        while(r > 0) {
+            const auto& r_entry = rhs_data[r - 1];
+            if(l > 0 && r_entry.first < data[l - 1].first) {
+                --l;
+                data[--w] = value_type{data[l].first, lf * data[l].second};
+            } else if(l > 0 && !(data[l - 1].first < r_entry.first)) {
+                --l;
+                --r;
+                data[--w] = value_type{
+                  data[l].first, lf * data[l].second + rf * r_entry.second};
+            } else {
+                --r;
+                data[--w] = value_type{r_entry.first, rf * r_entry.second};
+            }
+            has_zero = has_zero || data[w].second == mapped_type{0.0};
+        }
+        if(lf != mapped_type{1.0}) {
+            for(std::size_t i = 0; i < l; ++i) {
+                data[i].second *= lf;
+                has_zero = has_zero || data[i].second == mapped_type{0.0};
+            }
+        }
+
+        // Close the gap left by collapsed keys, along with any zeros
+        auto count = total;
+        if(w != l || has_zero) {
+            auto is_zero = [](const value_type& entry) {
+                return entry.second == mapped_type{0.0};
+            };
+            std::fill(data + l, data + w, value_type{});
+            count = static_cast<size_type>(
+              std::remove_if(data, data + total, is_zero) - data);
+        }
+        m_size_ = count;
+        if(is_inline()) {
+            std::copy(data, data + count, m_inline_.begin());
+            m_heap_.reset();
+        } else {
+            heap.resize(count);
+        }
+    }
+
+    /// The first stored entry whose key is not less than @p key
+    static const value_type* lower_bound_(const value_type* first,
+                                          const value_type* last,
+                                          const key_type& key) {
+        auto key_less = [](const value_type& entry, const key_type& k) {
+            return entry.first < k;
+        };
+        return std::lower_bound(first, last, key, key_less);
+    }
+
+    /// The number of entries
+    size_type m_size_ = 0;
+
+    /// The factor applied to all of the stored derivatives
+    mapped_type m_scale_ = 1.0;
+
+    /// The entries, sorted by key, while there are at most inline_size
+    std::array<value_type, inline_size> m_inline_ = {};
+
+    /// The entries, sorted by key, once there are more than inline_size
+    block_ptr m_heap_ = {};
+};
+
+/** @brief Whether a dependency storage type is a DepsMap
+ *
+ *  @tparam T The storage type
+ */
+template<typename T>
+struct is_deps_map : std::false_type {};
+
+/// @brief Specialization for DepsMap
+template<typename KeyType, typename ValueType, std::size_t InlineSize>
+struct is_deps_map<DepsMap<KeyType, ValueType, InlineSize>> : std::true_type {};
+
+/// @brief Convenience variable for is_deps_map
+template<typename T>
+inline constexpr bool is_deps_map_v = is_deps_map<T>::value;
+
+} // namespace sigma::detail_
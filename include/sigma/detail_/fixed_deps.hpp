@@ -0,0 +1,287 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/** @file fixed_deps.hpp
+ *  @brief Defines the FixedDeps class
+ */
+
+namespace sigma::detail_ {
+
+/** @brief Dense storage for dependencies on a fixed set of sources.
+ *
+ *  For models with a small set of sources known at compile time, the
+ *  dependencies are kept as a dense gradient with one slot per source,
+ *  stored inside the instance. Scaling and merging are fixed-length loops
+ *  over the slots, which the compiler can unroll and vectorize, and nothing
+ *  is ever allocated.
+ *
+ *  The sources are standardized: each slot holds the derivative with
+ *  respect to a source of unit standard deviation, i.e. the contribution of
+ *  that source to the standard deviation. This keeps the standard deviation
+ *  of the sources out of any global state, so different models can use the
+ *  same slots for their own sources.
+ *
+ *  Iteration, size() and the comparisons only consider the slots with a
+ *  non-zero value, so instances behave like the sparse storage would.
+ *
+ *  @tparam ValueType The type of the partial derivatives
+ *  @tparam N The number of sources
+ *
+ */
+template<typename ValueType, std::size_t N>
+class FixedDeps {
+public:
+    /// Type of the instance
+    using my_t = FixedDeps<ValueType, N>;
+
+    /// The type identifying a dependency, the index of its slot
+    using key_type = std::size_t;
+
+    /// The type of the partial derivatives
+    using mapped_type = ValueType;
+
+    /// The type of the (key, derivative) pairs
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The type of the dense gradient
+    using gradient_t = std::array<mapped_type, N>;
+
+    /// The type used for sizes
+    using size_type = std::size_t;
+
+    /// The number of sources
+    static constexpr size_type num_sources = N;
+
+    /** @brief Read-only iterator over the non-zero (key, derivative) pairs
+     *
+     *  Dereferencing yields the pairs by value.
+     */
+    class const_iterator {
+    public:
+        /// The iterator category
+        using iterator_category = std::forward_iterator_tag;
+
+        /// The type of the pairs
+        using value_type = typename my_t::value_type;
+
+        /// The type of the distance between iterators
+        using difference_type = std::ptrdiff_t;
+
+        /// Dereferencing yields a temporary pair
+        using reference = value_type;
+
+        /// Member access goes through a temporary pair
+        struct pointer {
+            /// The pair being accessed
+            value_type m_pair;
+            /// Access the pair
+            const value_type* operator->() const { return &m_pair; }
+        };
+
+        /// @brief Default ctor
+        const_iterator() noexcept = default;
+
+        /** @brief Construct from a gradient and the slot to start looking at
+         *
+         *  @param gradient The gradient being iterated over
+         *  @param slot The first slot that may be pointed to
+         *
+         *  @throw none No throw guarantee
+         */
+        const_iterator(const gradient_t* gradient, key_type slot) noexcept :
+          m_gradient_(gradient), m_slot_(slot) {
+            skip_zeros_();
+        }
+
+        /// @brief The pair pointed to
+        reference operator*() const {
+            return value_type{m_slot_, (*m_gradient_)[m_slot_]};
+        }
+
+        /// @brief Access a member of the pair pointed to
+        pointer operator->() const { return pointer{**this}; }
+
+        /// @brief Advance to the next non-zero slot
+        const_iterator& operator++() noexcept {
+            ++m_slot_;
+            skip_zeros_();
+            return *this;
+        }
+
+        /// @brief Advance to the next non-zero slot
+        const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        /// @brief Whether two iterators point to the same slot
+        friend bool operator==(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return lhs.m_slot_ == rhs.m_slot_;
+        }
+
+        /// @brief Whether two iterators point to different slots
+        friend bool operator!=(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        /// Move forward to the first non-zero slot, or the end
+        void skip_zeros_() noexcept {
+            while(m_slot_ < N && (*m_gradient_)[m_slot_] == mapped_type{0.0})
+                ++m_slot_;
+        }
+
+        /// The gradient being iterated over
+        const gradient_t* m_gradient_ = nullptr;
+
+        /// The slot pointed to
+        key_type m_slot_ = N;
+    };
+
+    /// @brief Default ctor
+    FixedDeps() noexcept = default;
+
+    /** @brief Construct storage depending on a single source
+     *
+     *  @param slot The slot of the source
+     *  @param deriv The derivative with respect to the standardized source
+     *
+     *  @throw std::out_of_range if @p slot is not less than N. Strong throw
+     *         guarantee.
+     */
+    FixedDeps(key_type slot, mapped_type deriv) {
+        if(slot >= N) throw std::out_of_range("Source slot is out of range");
+        m_gradient_[slot] = deriv;
+    }
+
+    /// @brief The dense gradient, including the slots that are zero
+    const gradient_t& gradient() const noexcept { return m_gradient_; }
+
+    /// @brief Iterator to the first non-zero (key, derivative) pair
+    const_iterator begin() const noexcept { return {&m_gradient_, 0}; }
+
+    /// @brief Iterator just past the last (key, derivative) pair
+    const_iterator end() const noexcept { return {&m_gradient_, N}; }
+
+    /// @brief The number of sources with a non-zero derivative
+    size_type size() const noexcept {
+        size_type count = 0;
+        for(const auto& deriv : m_gradient_) {
+            if(deriv != mapped_type{0.0}) ++count;
+        }
+        return count;
+    }
+
+    /// @brief Whether no source has a non-zero derivative
+    bool empty() const noexcept { return size() == 0; }
+
+    /** @brief Find the entry for a dependency
+     *
+     *  @param slot The dependency to look for
+     *
+     *  @return An iterator to the entry for @p slot, or end() if its
+     *          derivative is zero
+     *
+     *  @throw none No throw guarantee
+     */
+    const_iterator find(const key_type& slot) const {
+        if(slot >= N || m_gradient_[slot] == mapped_type{0.0}) return end();
+        return {&m_gradient_, slot};
+    }
+
+    /** @brief Count the entries for a dependency
+     *
+     *  @param slot The dependency to look for
+     *
+     *  @return 1 if the derivative for @p slot is non-zero, 0 otherwise
+     *
+     *  @throw none No throw guarantee
+     */
+    size_type count(const key_type& slot) const {
+        return find(slot) != end() ? 1 : 0;
+    }
+
+    /** @brief Multiply every derivative by a factor
+     *
+     *  @param factor The value the derivatives are multiplied by
+     *
+     *  @throw none No throw guarantee
+     */
+    void scale(mapped_type factor) noexcept {
+        for(auto& deriv : m_gradient_) deriv *= factor;
+    }
+
+    /** @brief Add a scaled set of dependencies to this one
+     *
+     *  Performs `*this += factor * other`. @p other may be this instance.
+     *
+     *  @param other The dependencies to add
+     *  @param factor The value the derivatives of @p other are multiplied by
+     *
+     *  @throw none No throw guarantee
+     */
+    void merge(const my_t& other, mapped_type factor) noexcept {
+        for(size_type i = 0; i < N; ++i) {
+            m_gradient_[i] += factor * other.m_gradient_[i];
+        }
+    }
+
+    /** @brief Remove the entries whose derivative is zero
+     *
+     *  Slots that are zero are never reported, so there is nothing to do.
+     *
+     *  @throw none No throw guarantee
+     */
+    void prune() noexcept {}
+
+    /** @brief Compare two gradients for equality
+     *
+     *  @param rhs The gradient to compare against
+     *
+     *  @return Whether both gradients are the same
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator==(const my_t& rhs) const noexcept {
+        return m_gradient_ == rhs.m_gradient_;
+    }
+
+    /** @brief Compare two gradients for inequality
+     *
+     *  @param rhs The gradient to compare against
+     *
+     *  @return Whether the gradients differ
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator!=(const my_t& rhs) const noexcept { return !(*this == rhs); }
+
+private:
+    /// The derivatives with respect to each of the standardized sources
+    gradient_t m_gradient_ = {};
+};
+
+/** @brief Whether a dependency storage type is a FixedDeps
+ *
+ *  @tparam T The storage type
+ */
+template<typename T>
+struct is_fixed_deps : std::false_type {};
+
+/// @brief Specialization for FixedDeps
+template<typename ValueType, std::size_t N>
+struct is_fixed_deps<FixedDeps<ValueType, N>> : std::true_type {};
+
+/// @brief Convenience variable for is_fixed_deps
+template<typename T>
+inline constexpr bool is_fixed_deps_v = is_fixed_deps<T>::value;
+
+} // namespace sigma::detail_
@@ -0,0 +1,471 @@
+#pragma once
+#include "sigma/detail_/deps_map.hpp"
+#include "sigma/memory_resource.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file hash_deps.hpp
+ *  @brief Defines the HashDeps class
+ */
+
+namespace sigma::detail_ {
+
+/** @brief Dependency storage backed by a hash table for very wide values.
+ *
+ *  Small sets of dependencies are kept in a sorted DepsMap. Once there are
+ *  at least min_hash_size of them, they move to an open-addressing hash
+ *  table with linear probing, so adding a set of dependencies costs an
+ *  amortized constant time per added entry, however many entries are
+ *  already present, where a sorted merge has to go over all of them. Keys
+ *  and derivatives are kept in two flat arrays that are at most half full.
+ *  If cancellations bring the size below a quarter of min_hash_size, the
+ *  storage goes back to the sorted layout.
+ *
+ *  Entries whose derivative cancels to zero stay in the table until it is
+ *  next rehashed, but are never reported. Iteration follows the layout of
+ *  the table rather than the order of the keys.
+ *
+ *  Like DepsMap, the table is copy-on-write, is allocated from the calling
+ *  thread's memory resource and carries a common scale factor.
+ *
+ *  @tparam KeyType The integral type identifying a dependency. Its largest
+ *                  value marks empty slots and may not be used as a key.
+ *  @tparam ValueType The type of the partial derivatives
+ *
+ */
+template<typename KeyType, typename ValueType>
+class HashDeps {
+    static_assert(std::is_integral_v<KeyType>,
+                  "The hash table needs integral keys");
+
+public:
+    /// Type of the instance
+    using my_t = HashDeps<KeyType, ValueType>;
+
+    /// The type identifying a dependency
+    using key_type = KeyType;
+
+    /// The type of the partial derivatives
+    using mapped_type = ValueType;
+
+    /// The type of the (key, derivative) pairs
+    using value_type = std::pair<key_type, mapped_type>;
+
+    /// The type of the sorted storage
+    using sparse_t = DepsMap<key_type, mapped_type>;
+
+    /// The type used for sizes
+    using size_type = std::size_t;
+
+    /// The smallest number of dependencies stored in the hash table
+    static constexpr size_type min_hash_size = 256;
+
+    /** @brief Read-only iterator over the (key, derivative) pairs
+     *
+     *  Dereferencing yields the pairs by value, with the scale factor
+     *  already applied to the derivative.
+     */
+    class const_iterator {
+    public:
+        /// The iterator category
+        using iterator_category = std::forward_iterator_tag;
+
+        /// The type of the pairs
+        using value_type = typename my_t::value_type;
+
+        /// The type of the distance between iterators
+        using difference_type = std::ptrdiff_t;
+
+        /// Dereferencing yields a temporary pair
+        using reference = value_type;
+
+        /// Member access goes through a temporary pair
+        using pointer = typename sparse_t::const_iterator::pointer;
+
+        /// @brief Default ctor
+        const_iterator() noexcept = default;
+
+        /** @brief Construct an iterator over the sorted layout
+         *
+         *  @param entry The sorted iterator to wrap
+         *
+         *  @throw none No throw guarantee
+         */
+        explicit const_iterator(
+          typename sparse_t::const_iterator entry) noexcept :
+          m_sparse_(entry) {}
+
+        /** @brief Construct an iterator over the slots of a hash table
+         *
+         *  @param keys The keys of the slots
+         *  @param derivs The derivatives of the slots
+         *  @param slot The first slot that may be pointed to
+         *  @param end The number of slots
+         *  @param scale The scale factor of the derivatives
+         *
+         *  @throw none No throw guarantee
+         */
+        const_iterator(const key_type* keys, const mapped_type* derivs,
+                       size_type slot, size_type end,
+                       mapped_type scale) noexcept :
+          m_keys_(keys),
+          m_derivs_(derivs),
+          m_slot_(slot),
+          m_end_(end),
+          m_scale_(scale) {
+            skip_unused_();
+        }
+
+        /// @brief The pair pointed to
+        reference operator*() const {
+            if(m_keys_ == nullptr) return *m_sparse_;
+            return value_type{m_keys_[m_slot_], m_scale_ * m_derivs_[m_slot_]};
+        }
+
+        /// @brief Access a member of the pair pointed to
+        pointer operator->() const { return pointer{**this}; }
+
+        /// @brief Advance to the next pair
+        const_iterator& operator++() noexcept {
+            if(m_keys_ == nullptr) {
+                ++m_sparse_;
+            } else {
+                ++m_slot_;
+                skip_unused_();
+            }
+            return *this;
+        }
+
+        /// @brief Advance to the next pair
+        const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            ++(*this);
+            return copy;
+        }
+
+        /// @brief Whether two iterators point to the same pair
+        friend bool operator==(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            if(lhs.m_keys_ == nullptr) return lhs.m_sparse_ == rhs.m_sparse_;
+            return lhs.m_keys_ == rhs.m_keys_ && lhs.m_slot_ == rhs.m_slot_;
+        }
+
+        /// @brief Whether two iterators point to different pairs
+        friend bool operator!=(const const_iterator& lhs,
+                               const const_iterator& rhs) {
+            return !(lhs == rhs);
+        }
+
+    private:
+        /// Move forward to the first slot holding a non-zero derivative
+        void skip_unused_() noexcept {
+            while(m_slot_ < m_end_ && (m_keys_[m_slot_] == empty_key ||
+                                       m_derivs_[m_slot_] == mapped_type{0.0}))
+                ++m_slot_;
+        }
+
+        /// The position in the sorted layout
+        typename sparse_t::const_iterator m_sparse_;
+
+        /// The keys of the hash table, null for the sorted layout
+        const key_type* m_keys_ = nullptr;
+
+        /// The derivatives of the hash table
+        const mapped_type* m_derivs_ = nullptr;
+
+        /// The position in the hash table
+        size_type m_slot_ = 0;
+
+        /// The number of slots
+        size_type m_end_ = 0;
+
+        /// The scale factor of the derivatives
+        mapped_type m_scale_ = 1.0;
+    };
+
+    /// @brief Default ctor
+    HashDeps() noexcept = default;
+
+    /** @brief Construct storage holding a single dependency
+     *
+     *  @param key The dependency
+     *  @param deriv The partial derivative with respect to @p key
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    HashDeps(key_type key, mapped_type deriv) : m_sparse_(key, deriv) {}
+
+    /// @brief Whether the dependencies are stored in the hash table
+    bool is_hashed() const noexcept { return m_table_ != nullptr; }
+
+    /// @brief Iterator to the first (key, derivative) pair
+    const_iterator begin() const noexcept {
+        if(!is_hashed()) return const_iterator(m_sparse_.begin());
+        return {m_table_->m_keys.data(), m_table_->m_derivs.data(), 0,
+                capacity_(), m_scale_};
+    }
+
+    /// @brief Iterator just past the last (key, derivative) pair
+    const_iterator end() const noexcept {
+        if(!is_hashed()) return const_iterator(m_sparse_.end());
+        return {m_table_->m_keys.data(), m_table_->m_derivs.data(),
+                capacity_(), capacity_(), m_scale_};
+    }
+
+    /// @brief The number of dependencies
+    size_type size() const noexcept {
+        return is_hashed() ? m_table_->m_nonzero : m_sparse_.size();
+    }
+
+    /// @brief Whether there are no dependencies
+    bool empty() const noexcept { return size() == 0; }
+
+    /** @brief Find the entry for a dependency
+     *
+     *  @param key The dependency to look for
+     *
+     *  @return An iterator to the entry for @p key, or end() if there is none
+     *
+     *  @throw none No throw guarantee
+     */
+    const_iterator find(const key_type& key) const {
+        if(!is_hashed()) return const_iterator(m_sparse_.find(key));
+        auto slot = probe_(*m_table_, key);
+        if(m_table_->m_keys[slot] == empty_key ||
+           m_table_->m_derivs[slot] == mapped_type{0.0})
+            return end();
+        return {m_table_->m_keys.data(), m_table_->m_derivs.data(), slot,
+                capacity_(), m_scale_};
+    }
+
+    /** @brief Count the entries for a dependency
+     *
+     *  @param key The dependency to look for
+     *
+     *  @return 1 if there is an entry for @p key, 0 otherwise
+     *
+     *  @throw none No throw guarantee
+     */
+    size_type count(const key_type& key) const {
+        return find(key) != end() ? 1 : 0;
+    }
+
+    /** @brief Multiply every derivative by a factor
+     *
+     *  Constant time in both layouts. Scaling by zero removes all of the
+     *  entries.
+     *
+     *  @param factor The value the derivatives are multiplied by
+     *
+     *  @throw none No throw guarantee
+     */
+    void scale(mapped_type factor) noexcept {
+        if(!is_hashed()) {
+            m_sparse_.scale(factor);
+        } else if(factor == mapped_type{0.0}) {
+            clear_();
+        } else {
+            m_scale_ *= factor;
+        }
+    }
+
+    /** @brief Add a scaled set of dependencies to this one
+     *
+     *  Performs `*this += factor * other`, whatever the layouts of the two
+     *  sets. Once this instance uses the hash table, this costs amortized
+     *  constant time per entry of @p other. @p other may be this instance.
+     *
+     *  @param other The dependencies to add
+     *  @param factor The value the derivatives of @p other are multiplied by
+     *
+     *  @throw std::bad_alloc if the allocation fails. Strong throw guarantee.
+     */
+    void merge(const my_t& other, mapped_type factor) {
+        if(other.empty() || factor == mapped_type{0.0}) return;
+        if(empty()) {
+            *this = other;
+            scale(factor);
+            return;
+        }
+        if(!is_hashed() && !other.is_hashed()) {
+            m_sparse_.merge(other.m_sparse_, factor);
+            if(m_sparse_.size() >= min_hash_size) {
+                rehash_(m_sparse_.size());
+                m_sparse_ = sparse_t{};
+            }
+            return;
+        }
+        if(&other == this) {
+            scale(mapped_type{1.0} + factor);
+            return;
+        }
+        if(!is_hashed()) {
+            // Add the smaller, sorted set to a copy of the table
+            my_t result(other);
+            result.scale(factor);
+            result.merge(*this, mapped_type{1.0});
+            *this = std::move(result);
+            return;
+        }
+
+        rehash_(m_table_->m_used + other.size());
+        for(const auto& [key, deriv] : other) {
+            accumulate_(*m_table_, key, factor * deriv);
+        }
+        if(m_table_->m_nonzero == 0) {
+            clear_();
+        } else if(m_table_->m_nonzero < min_hash_size / 4) {
+            std::vector<value_type> entries(begin(), end());
+            std::sort(entries.begin(), entries.end());
+            clear_();
+            m_sparse_ = sparse_t(entries.begin(), entries.end());
+        }
+    }
+
+    /** @brief Remove the entries whose derivative is zero
+     *
+     *  Zeros in the hash table are never reported, so only the sorted
+     *  layout has anything to do.
+     *
+     *  @throw std::bad_alloc if the sorted storage is shared and copying it
+     *         fails. Strong throw guarantee.
+     */
+    void prune() {
+        if(!is_hashed()) m_sparse_.prune();
+    }
+
+    /** @brief Compare two sets of dependencies for equality
+     *
+     *  @param rhs The set to compare against
+     *
+     *  @return Whether both hold the same (key, derivative) pairs, whatever
+     *          their layouts
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator==(const my_t& rhs) const {
+        if(size() != rhs.size()) return false;
+        if(!is_hashed() && !rhs.is_hashed()) return m_sparse_ == rhs.m_sparse_;
+        for(const auto& [key, deriv] : *this) {
+            auto entry = rhs.find(key);
+            if(entry == rhs.end() || entry->second != deriv) return false;
+        }
+        return true;
+    }
+
+    /** @brief Compare two sets of dependencies for inequality
+     *
+     *  @param rhs The set to compare against
+     *
+     *  @return Whether the sets hold different (key, derivative) pairs
+     *
+     *  @throw none No throw guarantee
+     */
+    bool operator!=(const my_t& rhs) const { return !(*this == rhs); }
+
+private:
+    /// The key marking an empty slot
+    static constexpr key_type empty_key = std::numeric_limits<key_type>::max();
+
+    /// The type of the allocator for the keys
+    using key_allocator_t = std::pmr::polymorphic_allocator<key_type>;
+
+    /// The type of the allocator for the derivatives
+    using deriv_allocator_t = std::pmr::polymorphic_allocator<mapped_type>;
+
+    /// The open-addressing hash table
+    struct Table {
+        /// The keys of the slots, empty_key for an empty slot
+        std::vector<key_type, key_allocator_t> m_keys;
+
+        /// The derivatives of the slots
+        std::vector<mapped_type, deriv_allocator_t> m_derivs;
+
+        /// The number of slots holding a key
+        size_type m_used;
+
+        /// The number of slots holding a non-zero derivative
+        size_type m_nonzero;
+    };
+
+    /// The number of slots of the table
+    size_type capacity_() const noexcept { return m_table_->m_keys.size(); }
+
+    /// The slot holding @p key, or the empty slot where it would go
+    static size_type probe_(const Table& table, key_type key) noexcept {
+        auto mask = table.m_keys.size() - 1;
+        auto hash = static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+        auto slot = static_cast<size_type>(hash ^ (hash >> 32)) & mask;
+        while(table.m_keys[slot] != empty_key && table.m_keys[slot] != key)
+            slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    /// Add @p deriv to the derivative of @p key, which must fit in the table
+    static void accumulate_(Table& table, key_type key, mapped_type deriv) {
+        auto slot   = probe_(table, key);
+        auto& value = table.m_derivs[slot];
+        if(table.m_keys[slot] == empty_key) {
+            table.m_keys[slot] = key;
+            ++table.m_used;
+            value = mapped_type{0.0};
+        }
+        auto was_zero = value == mapped_type{0.0};
+        value += deriv;
+        auto is_zero = value == mapped_type{0.0};
+        if(was_zero && !is_zero) ++table.m_nonzero;
+        if(!was_zero && is_zero) --table.m_nonzero;
+    }
+
+    /** Make the table unshared and unscaled, with room for @p used keys.
+     *
+     *  The entries currently stored are moved to a new table if needed,
+     *  dropping those that are zero.
+     */
+    void rehash_(size_type used) {
+        auto capacity = size_type{2 * min_hash_size};
+        while(capacity < 2 * used) capacity *= 2;
+        if(is_hashed() && m_table_.use_count() == 1 &&
+           m_scale_ == mapped_type{1.0} && capacity_() >= capacity)
+            return;
+
+        key_allocator_t key_alloc(sigma::get_memory_resource());
+        deriv_allocator_t deriv_alloc(key_alloc);
+        auto table = std::allocate_shared<Table>(
+          key_alloc,
+          Table{std::vector<key_type, key_allocator_t>(capacity, empty_key,
+                                                        key_alloc),
+                std::vector<mapped_type, deriv_allocator_t>(
+                  capacity, mapped_type{0.0}, deriv_alloc),
+                0, 0});
+        for(const auto& [key, deriv] : *this) accumulate_(*table, key, deriv);
+        m_table_ = std::move(table);
+        m_scale_ = mapped_type{1.0};
+    }
+
+    /// Remove all of the dependencies
+    void clear_() noexcept {
+        m_sparse_ = sparse_t{};
+        m_table_.reset();
+        m_scale_ = mapped_type{1.0};
+    }
+
+    /// The dependencies, while they are stored sorted
+    sparse_t m_sparse_ = {};
+
+    /// The dependencies, once they are stored in the hash table
+    std::shared_ptr<Table> m_table_ = {};
+
+    /// The factor applied to all of the derivatives in the hash table
+    mapped_type m_scale_ = 1.0;
+};
+
+} // namespace sigma::detail_
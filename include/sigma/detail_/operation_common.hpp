@@ -1,7 +1,15 @@
 #pragma once
 
 #include "sigma/detail_/setter.hpp"
+#include "sigma/memo.hpp"
+#include "sigma/memory_resource.hpp"
 #include "sigma/uncertain.hpp"
+#include <cstddef>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /** @file operation_common.hpp
  *  @brief Common implementation details for operations
@@ -12,18 +20,69 @@ namespace sigma::detail_ {
 /// Value of Pi
 constexpr double pi = 3.14159265358979323846;
 
+/** @brief Whether a type is an Uncertain
+ *
+ *  @tparam T The type to check
+ */
+template<typename T>
+struct is_uncertain : std::false_type {};
+
+/// @brief Specialization for Uncertain
+template<typename T, typename D>
+struct is_uncertain<Uncertain<T, D>> : std::true_type {};
+
+/** @brief The type of the first of several types that is an Uncertain
+ *
+ *  Has no member type if none of them is, which removes the operations
+ *  using it from overload resolution.
+ *
+ *  @tparam Ts The types
+ */
+template<typename... Ts>
+struct first_uncertain {};
+
+/// @brief Specialization checking the first of the types
+template<typename T, typename... Ts>
+struct first_uncertain<T, Ts...> : first_uncertain<Ts...> {};
+
+/// @brief Specialization for an Uncertain first type
+template<typename T, typename D, typename... Ts>
+struct first_uncertain<Uncertain<T, D>, Ts...> {
+    /// The Uncertain type
+    using type = Uncertain<T, D>;
+};
+
+/** @brief The mean value of an operand that may be a plain number
+ *
+ *  @tparam T The type of the operand
+ *  @param x The operand
+ *
+ *  @return The mean of @p x if it is an Uncertain, @p x itself otherwise
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+auto mean_of(const T& x) {
+    if constexpr(is_uncertain<T>::value) {
+        return x.mean();
+    } else {
+        return x;
+    }
+}
+
 /** @brief Generalized Inplace Unary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param c The variable being altered
  *  @param mean The new mean value of the variable
  *  @param dcda The partial derivative being added to the chain
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-void inplace_unary(Uncertain<T>& c, T mean, T dcda) {
-    detail_::Setter<Uncertain<T>> c_setter(c);
+template<typename T, typename D>
+void inplace_unary(Uncertain<T, D>& c, T mean, T dcda) {
+    detail_::Setter<Uncertain<T, D>> c_setter(c);
     c_setter.update_mean(mean);
     c_setter.update_derivatives(dcda);
 }
@@ -31,6 +90,7 @@ void inplace_unary(Uncertain<T>& c, T mean, T dcda) {
 /** @brief Generalized Unary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable being altered copied
  *  @param mean The new mean value of the variable
  *  @param dcda The partial derivative being added to the chain
@@ -40,16 +100,55 @@ void inplace_unary(Uncertain<T>& c, T mean, T dcda) {
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> unary_result(const Uncertain<T>& a, T mean, T dcda) {
-    Uncertain<T> c(a);
+template<typename T, typename D>
+Uncertain<T, D> unary_result(const Uncertain<T, D>& a, T mean, T dcda) {
+    Uncertain<T, D> c(a);
     detail_::inplace_unary(c, mean, dcda);
     return c;
 }
 
+/** @brief Generalized Unary Changes, reusing the storage of a temporary
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
+ *  @param a The variable being altered, which is consumed
+ *  @param mean The new mean value of the variable
+ *  @param dcda The partial derivative being added to the chain
+ *
+ *  @return @p a with the new mean value and its dependencies altered by
+ *          @p dcda.
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename D>
+Uncertain<T, D> unary_result(Uncertain<T, D>&& a, T mean, T dcda) {
+    detail_::inplace_unary(a, mean, dcda);
+    return std::move(a);
+}
+
+/** @brief Unary Changes from a kernel
+ *
+ *  @tparam Kernel The type of the kernel (see sigma::kernels)
+ *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
+ *  @param kernel The kernel giving the new mean and the partial derivative
+ *  @param a The variable being altered, which is consumed
+ *
+ *  @return @p a with the mean and dependencies altered by the function of
+ *          @p kernel
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Kernel, typename T, typename D>
+Uncertain<T, D> kernel_result(Kernel kernel, Uncertain<T, D>&& a) {
+    auto [mean, dcda] = kernel(a.mean());
+    return detail_::unary_result(std::move(a), mean, dcda);
+}
+
 /** @brief Generalized Inplace Binary Changes
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param c The variable being altered
  *  @param b The variable whose dependencies are being added to @p c's
  *  @param mean The new mean value of the variable
@@ -58,18 +157,21 @@ Uncertain<T> unary_result(const Uncertain<T>& a, T mean, T dcda) {
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-void inplace_binary(Uncertain<T>& c, const Uncertain<T>& b, T mean, T dcda,
-                    T dcdb) {
-    detail_::Setter<Uncertain<T>> c_setter(c);
+template<typename T, typename D>
+void inplace_binary(Uncertain<T, D>& c, const Uncertain<T, D>& b, T mean,
+                    T dcda, T dcdb) {
+    detail_::Setter<Uncertain<T, D>> c_setter(c);
     c_setter.update_mean(mean);
-    c_setter.update_derivatives(dcda, false);
-    c_setter.update_derivatives(b.deps(), dcdb);
+    c_setter.update_derivatives(dcda, b.deps(), dcdb);
 }
 
 /** @brief Generalized Binary Changes
+ *
+ *  If operations are memoized on the calling thread (see ScopedMemo), the
+ *  dependencies of the result are looked up in the cache first.
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable being altered copied
  *  @param b The variable whose dependencies are being added to @p a's
  *  @param mean The new mean value of the variable
@@ -81,14 +183,166 @@ void inplace_binary(Uncertain<T>& c, const Uncertain<T>& b, T mean, T dcda,
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> binary_result(const Uncertain<T>& a, const Uncertain<T>& b, T mean,
-                           T dcda, T dcdb) {
-    Uncertain<T> c(a);
+template<typename T, typename D>
+Uncertain<T, D> binary_result(const Uncertain<T, D>& a,
+                              const Uncertain<T, D>& b, T mean, T dcda,
+                              T dcdb) {
+    if constexpr(is_deps_map_v<D>) {
+        auto* cache = detail_::thread_memo_cache<D>();
+        if(cache && cache->cacheable(a.deps(), b.deps())) {
+            Uncertain<T, D> c(mean);
+            detail_::Setter<Uncertain<T, D>> c_setter(c);
+            if(auto* deps = cache->find(a.deps(), dcda, b.deps(), dcdb)) {
+                c_setter.set_derivatives(*deps);
+            } else {
+                c_setter.set_derivatives(a.deps());
+                c_setter.update_derivatives(dcda, b.deps(), dcdb);
+                cache->store(a.deps(), dcda, b.deps(), dcdb, c.deps());
+            }
+            return c;
+        }
+    }
+    Uncertain<T, D> c(a);
     detail_::inplace_binary(c, b, mean, dcda, dcdb);
     return c;
 }
 
+/** @brief Generalized Binary Changes, reusing the storage of a temporary
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
+ *  @param a The variable being altered, which is consumed
+ *  @param b The variable whose dependencies are being added to @p a's
+ *  @param mean The new mean value of the variable
+ *  @param dcda The partial derivative being added to the chain from @p a
+ *  @param dcdb The partial derivative being added to the chain from @p b
+ *
+ *  @return @p a with the new mean value and the dependencies of @p a and
+ *          @p b, altered respectively by @p dcda and @p dcdb.
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename D>
+Uncertain<T, D> binary_result(Uncertain<T, D>&& a, const Uncertain<T, D>& b,
+                              T mean, T dcda, T dcdb) {
+    detail_::inplace_binary(a, b, mean, dcda, dcdb);
+    return std::move(a);
+}
+
+/** @overload
+ *
+ *  The storage of @p b is reused for the result instead.
+ */
+template<typename T, typename D>
+Uncertain<T, D> binary_result(const Uncertain<T, D>& a, Uncertain<T, D>&& b,
+                              T mean, T dcda, T dcdb) {
+    detail_::inplace_binary(b, a, mean, dcdb, dcda);
+    return std::move(b);
+}
+
+/** @overload
+ *
+ *  The storage of whichever operand has more dependencies is reused.
+ */
+template<typename T, typename D>
+Uncertain<T, D> binary_result(Uncertain<T, D>&& a, Uncertain<T, D>&& b, T mean,
+                              T dcda, T dcdb) {
+    if(a.deps().size() >= b.deps().size()) {
+        return detail_::binary_result(std::move(a), b, mean, dcda, dcdb);
+    }
+    return detail_::binary_result(a, std::move(b), mean, dcda, dcdb);
+}
+
+/** @brief Linear combination of the dependencies of several variables
+ *
+ *  Sparse DepsMap storage is combined with a single k-way merge (see
+ *  DepsMap::combine), other storage types by merging the terms in turn.
+ *
+ *  @tparam InputIterator The type of the iterators over the terms
+ *  @param first The first term, a (pointer to dependencies, factor) pair
+ *  @param last Just past the last term
+ *
+ *  @return The sum of the dependencies of the terms, each multiplied by
+ *          its factor
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename InputIterator>
+auto linear_combination(InputIterator first, InputIterator last) {
+    using deps_t =
+      std::decay_t<decltype(*std::declval<InputIterator>()->first)>;
+    if constexpr(is_deps_map_v<deps_t>) {
+        return deps_t::combine(first, last);
+    } else {
+        deps_t result;
+        for(; first != last; ++first) {
+            result.merge(*first->first, first->second);
+        }
+        return result;
+    }
+}
+
+/** @brief The operand of an n-ary operation and the partial derivative of
+ *         the result with respect to it
+ *
+ *  @tparam UncertainType The type of the operand
+ */
+template<typename UncertainType>
+using operand_t =
+  std::pair<const UncertainType*, typename UncertainType::value_t>;
+
+/** @brief The type of the operands in a container of operand_t
+ *
+ *  @tparam Operands The type of the container
+ */
+template<typename Operands>
+using operands_uncertain_t = std::remove_cv_t<
+  std::remove_pointer_t<typename Operands::value_type::first_type>>;
+
+/** @brief Generalized N-ary Changes
+ *
+ *  The dependencies of all of the operands are combined at once, with a
+ *  single merge (see linear_combination), instead of one merge per
+ *  operand.
+ *
+ *  @tparam Operands The type of the container of operands, whose elements
+ *                   are operand_t
+ *  @param mean The mean value of the result
+ *  @param operands The operands, each with the partial derivative of the
+ *                  result with respect to it. The same variable may
+ *                  appear more than once.
+ *
+ *  @return A variable with the mean value @p mean and the dependencies of
+ *          the operands, each altered by its partial derivative.
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename Operands>
+operands_uncertain_t<Operands> nary_result(
+  typename operands_uncertain_t<Operands>::value_t mean,
+  const Operands& operands) {
+    using uncertain_t = operands_uncertain_t<Operands>;
+    using deps_map_t  = typename uncertain_t::deps_map_t;
+    using deriv_t     = typename deps_map_t::mapped_type;
+    using term_t      = std::pair<const deps_map_t*, deriv_t>;
+
+    // Only operations with very many operands need the heap for this
+    alignas(term_t) std::byte buffer[16 * sizeof(term_t)];
+    std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer),
+                                              sigma::get_memory_resource());
+    std::pmr::vector<term_t> terms(&arena);
+    terms.reserve(std::size(operands));
+    for(const auto& [operand, deriv] : operands) {
+        terms.emplace_back(&operand->deps(), deriv);
+    }
+
+    uncertain_t c(mean);
+    detail_::Setter<uncertain_t> c_setter(c);
+    c_setter.set_derivatives(
+      detail_::linear_combination(terms.begin(), terms.end()));
+    return c;
+}
+
 /** @brief Compute the numeric derivative of a function
  *
  *  @tparam FunctionType The type of the function @p f
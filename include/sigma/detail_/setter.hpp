@@ -1,6 +1,6 @@
 #pragma once
 #include "sigma/uncertain.hpp"
-#include <vector>
+#include <utility>
 
 /** @file setter.hpp
  *  @brief Defines the Setter class
@@ -31,8 +31,8 @@ public:
     /// The type of a standard deviation that this instance depends on
     using dep_sd_t = typename uncertain_t::dep_sd_t;
 
-    /// A pointer to a dependency of this variable
-    using dep_sd_ptr = typename uncertain_t::dep_sd_ptr;
+    /// The ID of a dependency of this variable
+    using dep_id_t = typename uncertain_t::dep_id_t;
 
     /// The type of the map holding the variable's dependencies
     using deps_map_t = typename uncertain_t::deps_map_t;
@@ -56,37 +56,30 @@ public:
     /** @brief Calculate the standatd deviation of m_x_ based on the
      *         uncertainty of its dependencies.
      *
+     *  Dependencies that no longer contribute are removed first. Operations
+     *  do not need to call this, since Uncertain::sd() computes an out of
+     *  date standard deviation on demand.
+     *
      *  @throw none No throw guarantee
      */
     void update_sd() {
-        m_x_.m_sd_ = 0.0;
-        std::vector<dep_sd_ptr> zero_contributions{};
-        for(const auto& [dep, deriv] : m_x_.m_deps_) {
-            if(deriv == 0.0) {
-                zero_contributions.emplace_back(dep);
-                continue;
-            }
-            m_x_.m_sd_ += std::pow(*dep.get() * deriv, 2.0);
-        }
-        for(const auto& dep : zero_contributions) { m_x_.m_deps_.erase(dep); }
-        m_x_.m_sd_ = std::sqrt(m_x_.m_sd_);
+        m_x_.m_deps_.prune();
+        m_x_.m_sd_.set(m_x_.compute_sd_(), uncertain_t::sd_stamp_());
     }
 
     /** @brief Update of existing derivatives
      *
      *  @param dxda The partial derivative of the variable
      *  @param call_update_std Whether or not to update the standard deviation
-     *                         after updating the dependencies. Primarily for
-     *                         minimizing repetitive work when multiple updates
-     *                         will be performed
+     *                         immediately. Otherwise it is computed the next
+     *                         time it is requested.
      *
      *  @throw none No throw guarantee
      */
-    void update_derivatives(value_t dxda, bool call_update_std = true) {
+    void update_derivatives(value_t dxda, bool call_update_std = false) {
         if(dxda != 1.0) {
-            for(const auto& [dep, deriv] : m_x_.m_deps_) {
-                m_x_.m_deps_[dep] *= dxda;
-            }
+            m_x_.m_deps_.scale(dxda);
+            m_x_.m_sd_.invalidate();
         }
         if(call_update_std) update_sd();
     }
@@ -97,25 +90,62 @@ public:
      *  @param dxda The partial derivative of this variable with respect to
      *              the dependency
      *  @param call_update_std Whether or not to update the standard deviation
-     *                         after updating the dependencies. Primarily for
-     *                         minimizing repetitive work when multiple updates
-     *                         will be performed
+     *                         immediately. Otherwise it is computed the next
+     *                         time it is requested.
      *
      *  @throw none No throw guarantee
      */
     void update_derivatives(const deps_map_t& deps, value_t dxda,
-                            bool call_update_std = true) {
-        for(const auto& [dep, deriv] : deps) {
-            auto new_deriv = dxda * deriv;
-            if(m_x_.m_deps_.count(dep) != 0) {
-                m_x_.m_deps_[dep] += new_deriv;
-            } else {
-                m_x_.m_deps_.emplace(std::make_pair(std::move(dep), new_deriv));
-            }
+                            bool call_update_std = false) {
+        if(!deps.empty()) {
+            m_x_.m_deps_.merge(deps, dxda);
+            m_x_.m_sd_.invalidate();
         }
         if(call_update_std) update_sd();
     }
 
+    /** @brief Update of existing derivatives and addition of new ones
+     *
+     *  Equivalent to update_derivatives(dxda) followed by
+     *  update_derivatives(deps, dxdb), except that @p deps may also be the
+     *  dependencies of the wrapped variable itself.
+     *
+     *  @param dxda The partial derivative of the variable with respect to
+     *              its current value
+     *  @param deps The dependencies to add
+     *  @param dxdb The partial derivative of the variable with respect to
+     *              the variable owning @p deps
+     *  @param call_update_std Whether or not to update the standard deviation
+     *                         immediately. Otherwise it is computed the next
+     *                         time it is requested.
+     *
+     *  @throw none No throw guarantee
+     */
+    void update_derivatives(value_t dxda, const deps_map_t& deps,
+                            value_t dxdb, bool call_update_std = false) {
+        if(&deps == &m_x_.m_deps_) {
+            update_derivatives(dxda + dxdb, call_update_std);
+        } else {
+            update_derivatives(dxda);
+            update_derivatives(deps, dxdb, call_update_std);
+        }
+    }
+
+    /** @brief Replacement of all of the derivatives
+     *
+     *  @param deps The new dependencies of the variable
+     *  @param call_update_std Whether or not to update the standard deviation
+     *                         immediately. Otherwise it is computed the next
+     *                         time it is requested.
+     *
+     *  @throw none No throw guarantee
+     */
+    void set_derivatives(deps_map_t deps, bool call_update_std = false) {
+        m_x_.m_deps_ = std::move(deps);
+        m_x_.m_sd_.invalidate();
+        if(call_update_std) update_sd();
+    }
+
 private:
     /// The variable being modified
     uncertain_t& m_x_;
@@ -0,0 +1,298 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file source_registry.hpp
+ *  @brief Defines the SourceRegistry class
+ */
+
+namespace sigma::detail_ {
+
+/** @brief Central record of the independent sources of uncertainty.
+ *
+ *  Every independent variable is identified by an integer ID, assigned in
+ *  increasing order as the variables are created, and its standard deviation
+ *  is stored here under that ID. Uncertain instances then only need to carry
+ *  the IDs of their dependencies, which are trivially copyable and compare in
+ *  creation order.
+ *
+ *  Storage is split into chunks of geometrically increasing size that are
+ *  never moved once allocated, so looking up a standard deviation takes no
+ *  lock and registering a new source only contends on an atomic counter.
+ *
+ *  Records are never freed, but their IDs can be recycled: while a thread
+ *  records its sources (see record()), the IDs it registers are collected,
+ *  and once handed back with release() add() reuses them on that thread,
+ *  smallest first, before taking new ones. The number of records then
+ *  stays bounded by the largest number of sources alive at once.
+ *
+ *  The standard deviation of a source may be changed afterwards with
+ *  set_sd(), which also bumps the generation of the registry, so that the
+ *  standard deviations cached by the variables depending on any source are
+ *  computed again the next time they are requested.
+ *
+ *  There is one registry per pair of value and ID types, so variables with
+ *  narrow IDs only use up the IDs of their own type.
+ *
+ *  @tparam ValueType The type of the standard deviations
+ *  @tparam IdType The unsigned integral type of the source IDs
+ *
+ */
+template<typename ValueType, typename IdType = std::uint64_t>
+class SourceRegistry {
+    static_assert(std::is_integral_v<IdType> && std::is_unsigned_v<IdType>,
+                  "Source IDs are unsigned integers");
+
+public:
+    /// Type of the instance
+    using my_t = SourceRegistry<ValueType, IdType>;
+
+    /// The type of the standard deviations
+    using value_t = ValueType;
+
+    /// The type of the source IDs
+    using id_t = IdType;
+
+    /// The type of the number of records, wide enough for any ID type
+    using size_type = std::uint64_t;
+
+    /// The type of the generation of the standard deviations
+    using generation_t = std::uint32_t;
+
+    /// @brief Deleted copy ctor, there is one registry per type
+    SourceRegistry(const my_t&) = delete;
+
+    /// @brief Deleted copy assignment, there is one registry per type
+    my_t& operator=(const my_t&) = delete;
+
+    /// @brief Release the chunks of the registry
+    ~SourceRegistry() noexcept {
+        for(auto& chunk : m_chunks_) delete[] chunk.load();
+    }
+
+    /** @brief Get the registry for these value and ID types
+     *
+     *  @return The process-wide registry instance
+     *
+     *  @throw none No throw guarantee
+     */
+    static my_t& instance() {
+        static my_t registry;
+        return registry;
+    }
+
+    /** @brief Register a new independent source
+     *
+     *  @param sd The standard deviation of the source
+     *
+     *  @return The ID assigned to the new source
+     *
+     *  @throw std::overflow_error if every ID of the ID type has been handed
+     *         out and none was released. Strong throw guarantee.
+     *  @throw std::bad_alloc if a new chunk cannot be allocated. Strong throw
+     *         guarantee.
+     */
+    id_t add(value_t sd) {
+        auto* recorded = recorder_();
+        if(recorded) recorded->reserve(recorded->size() + 1);
+        auto& released = released_();
+        id_t id;
+        if(!released.empty()) {
+            id = released.back();
+            released.pop_back();
+        } else {
+            id = take_id_();
+        }
+        auto [chunk, offset] = locate_(id);
+        auto* data           = m_chunks_[chunk].load(std::memory_order_acquire);
+        if(data == nullptr) data = allocate_chunk_(chunk);
+        data[offset] = sd;
+        if(recorded) recorded->push_back(id);
+        return id;
+    }
+
+    /** @brief Collect the IDs registered by the calling thread
+     *
+     *  Every ID add() hands out on the calling thread is appended to
+     *  @p ids, until recording is switched to another vector.
+     *
+     *  @param ids Where to collect the IDs, null to stop recording
+     *
+     *  @return The vector the IDs were collected in before, null if none
+     *
+     *  @throw none No throw guarantee
+     */
+    std::vector<id_t>* record(std::vector<id_t>* ids) noexcept {
+        auto* previous = recorder_();
+        recorder_()    = ids;
+        return previous;
+    }
+
+    /** @brief Hand IDs back, for add() to reuse on the calling thread
+     *
+     *  Nothing may use the sources afterwards.
+     *
+     *  @param ids IDs returned by add()
+     *
+     *  @throw std::bad_alloc if the IDs cannot be stored. Strong throw
+     *         guarantee.
+     */
+    void release(const std::vector<id_t>& ids) {
+        auto& released = released_();
+        released.insert(released.end(), ids.begin(), ids.end());
+        std::sort(released.begin(), released.end(), std::greater<id_t>{});
+    }
+
+    /** @brief Get the standard deviation of a source
+     *
+     *  @param id The ID of the source, as returned by add()
+     *
+     *  @return The standard deviation of the source
+     *
+     *  @throw none No throw guarantee
+     */
+    value_t sd(id_t id) const {
+        auto [chunk, offset] = locate_(id);
+        return m_chunks_[chunk].load(std::memory_order_acquire)[offset];
+    }
+
+    /** @brief Change the standard deviation of a source
+     *
+     *  Must not be called while other threads use the variables depending
+     *  on the source.
+     *
+     *  @param id The ID of the source, as returned by add()
+     *  @param sd The new standard deviation of the source
+     *
+     *  @throw none No throw guarantee
+     */
+    void set_sd(id_t id, value_t sd) noexcept {
+        auto [chunk, offset] = locate_(id);
+        m_chunks_[chunk].load(std::memory_order_acquire)[offset] = sd;
+        // Zero marks a cache that is out of date, so it is skipped
+        auto next = m_generation_.load(std::memory_order_relaxed) + 1;
+        if(next == 0) next = 1;
+        m_generation_.store(next, std::memory_order_release);
+    }
+
+    /** @brief The generation of the standard deviations
+     *
+     *  @return A number that changes every time set_sd() is called, and
+     *          is never zero
+     *
+     *  @throw none No throw guarantee
+     */
+    generation_t generation() const noexcept {
+        return m_generation_.load(std::memory_order_acquire);
+    }
+
+    /** @brief The number of records, i.e. of IDs handed out at least once
+     *
+     *  @throw none No throw guarantee
+     */
+    size_type size() const noexcept {
+        return m_next_.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// Log2 of the size of the first chunk
+    static constexpr std::size_t first_chunk_bits = 10;
+
+    /// The number of bits of the ID type
+    static constexpr std::size_t id_bits = std::numeric_limits<id_t>::digits;
+
+    static_assert(id_bits > first_chunk_bits,
+                  "The ID type must be wider than the first chunk");
+
+    /// Enough chunks to exhaust the ID type
+    static constexpr std::size_t max_chunks =
+      id_bits - first_chunk_bits + (id_bits < 64 ? 1 : 0);
+
+    /// Registries are only created through instance()
+    SourceRegistry() noexcept = default;
+
+    /// The size of a chunk
+    static constexpr std::size_t chunk_size_(std::size_t chunk) {
+        return std::size_t{1} << (chunk + first_chunk_bits);
+    }
+
+    /// Index of the highest set bit of a non-zero value
+    static std::size_t highest_bit_(size_type n) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(n);
+#else
+        std::size_t bit = 0;
+        while(n >>= 1) ++bit;
+        return bit;
+#endif
+    }
+
+    /// The chunk holding an ID and the ID's offset within it
+    static std::pair<std::size_t, std::size_t> locate_(id_t id) noexcept {
+        auto shifted = static_cast<size_type>(id) + chunk_size_(0);
+        auto chunk   = highest_bit_(shifted) - first_chunk_bits;
+        return {chunk, static_cast<std::size_t>(shifted - chunk_size_(chunk))};
+    }
+
+    /// Take the next new ID, unless the ID type is exhausted
+    id_t take_id_() {
+        if constexpr(id_bits < 64) {
+            constexpr size_type max_id = std::numeric_limits<id_t>::max();
+            auto next = m_next_.load(std::memory_order_relaxed);
+            do {
+                if(next > max_id) {
+                    throw std::overflow_error(
+                      "Too many sources for the ID type");
+                }
+            } while(!m_next_.compare_exchange_weak(next, next + 1,
+                                                   std::memory_order_relaxed));
+            return static_cast<id_t>(next);
+        } else {
+            return m_next_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// The IDs released on the calling thread, largest first
+    static std::vector<id_t>& released_() noexcept {
+        thread_local std::vector<id_t> ids;
+        return ids;
+    }
+
+    /// Where the calling thread records the IDs it registers, if anywhere
+    static std::vector<id_t>*& recorder_() noexcept {
+        thread_local std::vector<id_t>* ids = nullptr;
+        return ids;
+    }
+
+    /// Allocate a chunk, unless another thread beat us to it
+    value_t* allocate_chunk_(std::size_t chunk) {
+        auto* data          = new value_t[chunk_size_(chunk)];
+        value_t* registered = nullptr;
+        if(!m_chunks_[chunk].compare_exchange_strong(
+             registered, data, std::memory_order_acq_rel)) {
+            delete[] data;
+            return registered;
+        }
+        return data;
+    }
+
+    /// The next ID to hand out
+    std::atomic<size_type> m_next_{0};
+
+    /// Changes whenever a standard deviation does
+    std::atomic<generation_t> m_generation_{1};
+
+    /// The chunks holding the standard deviations
+    std::array<std::atomic<value_t*>, max_chunks> m_chunks_{};
+};
+
+} // namespace sigma::detail_
@@ -0,0 +1,91 @@
+#pragma once
+#include <cmath>
+#include <limits>
+
+/** @file special_functions.hpp
+ *  @brief Special functions missing from the standard library
+ */
+
+namespace sigma::detail_ {
+
+/** @brief The digamma function, the derivative of lgamma
+ *
+ *  Negative arguments are reflected with
+ *  `psi(x) = psi(1 - x) - pi / tan(pi * x)`, small arguments are shifted up
+ *  to 10 with the recurrence `psi(x) = psi(x + 1) - 1 / x`, and the
+ *  asymptotic expansion is summed from there, which is accurate to about
+ *  the precision of a double.
+ *
+ *  @tparam T The numeric type
+ *  @param x The argument
+ *
+ *  @return The digamma function of @p x, or NaN at its poles, the
+ *          non-positive integers
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+T digamma(T x) {
+    constexpr T pi = 3.14159265358979323846;
+    if(x <= T{0} && x == std::floor(x)) {
+        return std::numeric_limits<T>::quiet_NaN();
+    }
+    T result = 0.0;
+    if(x < T{0}) {
+        result -= pi / std::tan(pi * x);
+        x = T{1} - x;
+    }
+    for(; x < T{10}; x += T{1}) result -= T{1} / x;
+
+    // ln(x) - 1/(2x) - sum_k B_2k / (2k x^2k)
+    T inv2 = T{1} / (x * x);
+    T series =
+      inv2 *
+      (T{1} / 12 -
+       inv2 * (T{1} / 120 -
+               inv2 * (T{1} / 252 -
+                       inv2 * (T{1} / 240 -
+                               inv2 * (T{1} / 132 - inv2 * T{691} / 32760)))));
+    return result + std::log(x) - T{0.5} / x - series;
+}
+
+/** @brief The trigamma function, the derivative of digamma
+ *
+ *  Uses the same reflection, recurrence and asymptotic expansion as
+ *  digamma().
+ *
+ *  @tparam T The numeric type
+ *  @param x The argument
+ *
+ *  @return The trigamma function of @p x, or NaN at its poles, the
+ *          non-positive integers
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+T trigamma(T x) {
+    constexpr T pi = 3.14159265358979323846;
+    if(x <= T{0} && x == std::floor(x)) {
+        return std::numeric_limits<T>::quiet_NaN();
+    }
+    if(x < T{0}) {
+        T s = std::sin(pi * x);
+        return pi * pi / (s * s) - trigamma(T{1} - x);
+    }
+    T result = 0.0;
+    for(; x < T{10}; x += T{1}) result += T{1} / (x * x);
+
+    // 1/x + 1/(2x^2) + sum_k B_2k / x^(2k+1)
+    T inv  = T{1} / x;
+    T inv2 = inv * inv;
+    T series =
+      inv2 * inv *
+      (T{1} / 6 -
+       inv2 * (T{1} / 30 -
+               inv2 * (T{1} / 42 -
+                       inv2 * (T{1} / 30 -
+                               inv2 * (T{5} / 66 - inv2 * T{691} / 2730)))));
+    return result + inv + T{0.5} * inv2 + series;
+}
+
+} // namespace sigma::detail_
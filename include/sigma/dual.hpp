@@ -0,0 +1,699 @@
+#pragma once
+#include "sigma/kernels.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+/** @file dual.hpp
+ *  @brief Dual numbers for forward-mode differentiation of generic functions
+ */
+
+namespace sigma {
+
+/** @brief A value and its gradient with respect to a fixed number of
+ *         variables
+ *
+ *  Arithmetic on dual numbers applies the chain rule as it goes, so that a
+ *  generic function evaluated once on them returns its value together with
+ *  its exact gradient. This is what sigma::lift() is built on. The math
+ *  functions are found by argument-dependent lookup, so a function written
+ *  as e.g. `using std::sin; return sin(x) * y;` works on plain numbers and
+ *  on dual numbers alike.
+ *
+ *  @tparam T The numeric type
+ *  @tparam N The number of variables
+ */
+template<typename T, std::size_t N>
+class Dual {
+private:
+    /// Type of this instance
+    using my_t = Dual<T, N>;
+
+public:
+    /// Type of the value
+    using value_t = T;
+
+    /// Type of the gradient
+    using gradient_t = std::array<T, N>;
+
+    /** @brief Construct a constant, with a value of zero
+     *
+     *  @throw none No throw guarantee
+     */
+    Dual() : Dual(T{0}) {}
+
+    /** @brief Construct a constant
+     *
+     *  Implicit, so that constants mix with dual numbers the way they mix
+     *  with plain numbers.
+     *
+     *  @param value The value of the constant
+     *
+     *  @throw none No throw guarantee
+     */
+    Dual(T value) : m_value_(value), m_gradient_{} {}
+
+    /** @brief Construct from a value and a gradient
+     *
+     *  @param value The value
+     *  @param gradient The gradient of the value
+     *
+     *  @throw none No throw guarantee
+     */
+    Dual(T value, const gradient_t& gradient) :
+      m_value_(value), m_gradient_(gradient) {}
+
+    /** @brief Construct the variable with the given index
+     *
+     *  @param value The value of the variable
+     *  @param index The index of the variable, less than N
+     *
+     *  @return A dual number whose gradient is the unit vector along
+     *          @p index
+     *
+     *  @throw none No throw guarantee
+     */
+    static my_t variable(T value, std::size_t index) {
+        my_t x(value);
+        x.m_gradient_[index] = T{1};
+        return x;
+    }
+
+    /** @brief Get the value
+     *
+     *  @return The value
+     *
+     *  @throw none No throw guarantee
+     */
+    T value() const { return m_value_; }
+
+    /** @brief Get the gradient
+     *
+     *  @return The partial derivatives of the value with respect to each of
+     *          the variables
+     *
+     *  @throw none No throw guarantee
+     */
+    const gradient_t& gradient() const { return m_gradient_; }
+
+    /** @brief Get one partial derivative
+     *
+     *  @param index The index of the variable, less than N
+     *
+     *  @return The partial derivative of the value with respect to the
+     *          variable with index @p index
+     *
+     *  @throw none No throw guarantee
+     */
+    T derivative(std::size_t index) const { return m_gradient_[index]; }
+
+    /** @brief Add another dual number to this one
+     *
+     *  @param rhs The dual number to add
+     *
+     *  @return This instance, after the addition
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t& operator+=(const my_t& rhs) {
+        return chain_(m_value_ + rhs.m_value_, T{1}, rhs, T{1});
+    }
+
+    /** @brief Subtract another dual number from this one
+     *
+     *  @param rhs The dual number to subtract
+     *
+     *  @return This instance, after the subtraction
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t& operator-=(const my_t& rhs) {
+        return chain_(m_value_ - rhs.m_value_, T{1}, rhs, T{-1});
+    }
+
+    /** @brief Multiply this dual number by another one
+     *
+     *  @param rhs The dual number to multiply by
+     *
+     *  @return This instance, after the multiplication
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t& operator*=(const my_t& rhs) {
+        return chain_(m_value_ * rhs.m_value_, rhs.m_value_, rhs, m_value_);
+    }
+
+    /** @brief Divide this dual number by another one
+     *
+     *  @param rhs The dual number to divide by
+     *
+     *  @return This instance, after the division
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t& operator/=(const my_t& rhs) {
+        T value = m_value_ / rhs.m_value_;
+        return chain_(value, T{1} / rhs.m_value_, rhs, -value / rhs.m_value_);
+    }
+
+private:
+    /** @brief Set the value, and the gradient to a linear combination of
+     *         this gradient and that of @p rhs
+     *
+     *  @param value The new value
+     *  @param dlhs The partial derivative with respect to this instance
+     *  @param rhs The other operand
+     *  @param drhs The partial derivative with respect to @p rhs
+     *
+     *  @return This instance, after the update
+     *
+     *  @throw none No throw guarantee
+     */
+    my_t& chain_(T value, T dlhs, const my_t& rhs, T drhs) {
+        m_value_ = value;
+        for(std::size_t i = 0; i < N; ++i) {
+            m_gradient_[i] = dlhs * m_gradient_[i] + drhs * rhs.m_gradient_[i];
+        }
+        return *this;
+    }
+
+    /// The value
+    T m_value_;
+
+    /// The gradient
+    gradient_t m_gradient_;
+};
+
+namespace detail_ {
+
+/** @brief Whether a type is a Dual
+ *
+ *  @tparam T The type to check
+ */
+template<typename T>
+struct is_dual : std::false_type {};
+
+/// @brief Specialization for Dual
+template<typename T, std::size_t N>
+struct is_dual<Dual<T, N>> : std::true_type {};
+
+/** @brief Enables the mixed operations between a dual number and a plain
+ *         number
+ *
+ *  An int rather than void, so that these operators do not clash with the
+ *  equally generic ones for sigma::Expression.
+ *
+ *  @tparam L The type of the left operand
+ *  @tparam R The type of the right operand
+ */
+template<typename L, typename R>
+using enable_if_dual_operands_t = std::enable_if_t<
+  (is_dual<L>::value && (is_dual<R>::value || std::is_arithmetic_v<R>)) ||
+  (std::is_arithmetic_v<L> && is_dual<R>::value),
+  int>;
+
+/** @brief The value of an operand that may be a plain number
+ *
+ *  @tparam T The type of the operand
+ *  @param x The operand
+ *
+ *  @return The value of @p x if it is a Dual, @p x itself otherwise
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+auto dual_value(const T& x) {
+    if constexpr(is_dual<T>::value) {
+        return x.value();
+    } else {
+        return x;
+    }
+}
+
+/** @brief Apply a kernel to a dual number
+ *
+ *  @tparam Kernel The type of the kernel
+ *  @tparam T The numeric type
+ *  @tparam N The number of variables
+ *  @param kernel The kernel, see sigma::kernels
+ *  @param x The argument
+ *
+ *  @return The function of @p x, with its gradient by the chain rule
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Kernel, typename T, std::size_t N>
+Dual<T, N> dual_kernel(Kernel kernel, const Dual<T, N>& x) {
+    auto [value, deriv] = kernel(x.value());
+    typename Dual<T, N>::gradient_t gradient;
+    for(std::size_t i = 0; i < N; ++i) gradient[i] = deriv * x.derivative(i);
+    return Dual<T, N>(value, gradient);
+}
+
+/** @brief A function of two dual numbers, given its value and partial
+ *         derivatives
+ *
+ *  @tparam T The numeric type
+ *  @tparam N The number of variables
+ *  @param value The value of the function
+ *  @param dcda The partial derivative with respect to @p a
+ *  @param a The first argument
+ *  @param dcdb The partial derivative with respect to @p b
+ *  @param b The second argument
+ *
+ *  @return The function, with its gradient by the chain rule
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> dual_binary(T value, T dcda, const Dual<T, N>& a, T dcdb,
+                       const Dual<T, N>& b) {
+    typename Dual<T, N>::gradient_t gradient;
+    for(std::size_t i = 0; i < N; ++i) {
+        gradient[i] = dcda * a.derivative(i) + dcdb * b.derivative(i);
+    }
+    return Dual<T, N>(value, gradient);
+}
+
+} // namespace detail_
+
+// -- Arithmetic ---------------------------------------------------------------
+
+/** @brief Identity of a dual number
+ *
+ *  @param a The dual number
+ *
+ *  @return A copy of @p a
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> operator+(const Dual<T, N>& a) {
+    return a;
+}
+
+/** @brief Negation of a dual number
+ *
+ *  @param a The dual number
+ *
+ *  @return The negation of @p a
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> operator-(const Dual<T, N>& a) {
+    return Dual<T, N>(T{0}) -= a;
+}
+
+/** @brief Sum of two operands, at least one of them a dual number
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The sum of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+auto operator+(const L& a, const R& b) {
+    if constexpr(detail_::is_dual<L>::value) {
+        L c(a);
+        return c += L(b);
+    } else {
+        R c(a);
+        return c += b;
+    }
+}
+
+/** @brief Difference of two operands, at least one of them a dual number
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The difference of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+auto operator-(const L& a, const R& b) {
+    if constexpr(detail_::is_dual<L>::value) {
+        L c(a);
+        return c -= L(b);
+    } else {
+        R c(a);
+        return c -= b;
+    }
+}
+
+/** @brief Product of two operands, at least one of them a dual number
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The product of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+auto operator*(const L& a, const R& b) {
+    if constexpr(detail_::is_dual<L>::value) {
+        L c(a);
+        return c *= L(b);
+    } else {
+        R c(a);
+        return c *= b;
+    }
+}
+
+/** @brief Quotient of two operands, at least one of them a dual number
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The quotient of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+auto operator/(const L& a, const R& b) {
+    if constexpr(detail_::is_dual<L>::value) {
+        L c(a);
+        return c /= L(b);
+    } else {
+        R c(a);
+        return c /= b;
+    }
+}
+
+// -- Comparisons --------------------------------------------------------------
+
+/** @brief Compare the values of two operands, at least one of them a dual
+ *         number
+ *
+ *  The comparisons only look at the values, so that the branches of a
+ *  function are taken as they would be for plain numbers.
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return Whether the value of @p a is less than that of @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+bool operator<(const L& a, const R& b) {
+    return detail_::dual_value(a) < detail_::dual_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+bool operator>(const L& a, const R& b) {
+    return detail_::dual_value(a) > detail_::dual_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+bool operator<=(const L& a, const R& b) {
+    return detail_::dual_value(a) <= detail_::dual_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+bool operator>=(const L& a, const R& b) {
+    return detail_::dual_value(a) >= detail_::dual_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+bool operator==(const L& a, const R& b) {
+    return detail_::dual_value(a) == detail_::dual_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_dual_operands_t<L, R> = 0>
+bool operator!=(const L& a, const R& b) {
+    return detail_::dual_value(a) != detail_::dual_value(b);
+}
+
+// -- Functions ----------------------------------------------------------------
+
+/** @brief Absolute value of a dual number
+ *
+ *  @param a The dual number
+ *
+ *  @return The absolute value of @p a
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> abs(const Dual<T, N>& a) {
+    return (a.value() >= T{0}) ? a : -a;
+}
+
+/** @brief Power of a dual number, with a plain exponent
+ *
+ *  @param a The base
+ *  @param exp The exponent
+ *
+ *  @return @p a raised to @p exp
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N, typename U,
+         typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+Dual<T, N> pow(const Dual<T, N>& a, U exp) {
+    auto kernel = [e = static_cast<T>(exp)](T x) {
+        return kernels::ValueDeriv<T>{std::pow(x, e), e * std::pow(x, e - 1)};
+    };
+    return detail_::dual_kernel(kernel, a);
+}
+
+/** @brief Power of two dual numbers
+ *
+ *  @param a The base
+ *  @param exp The exponent
+ *
+ *  @return @p a raised to @p exp
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> pow(const Dual<T, N>& a, const Dual<T, N>& exp) {
+    T value = std::pow(a.value(), exp.value());
+    T dcda  = exp.value() * std::pow(a.value(), exp.value() - 1);
+    T dcdb  = std::log(a.value()) * value;
+    return detail_::dual_binary(value, dcda, a, dcdb, exp);
+}
+
+/** @brief Power of a plain base, with a dual exponent
+ *
+ *  @param a The base
+ *  @param exp The exponent
+ *
+ *  @return @p a raised to @p exp
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename U, typename T, std::size_t N,
+         typename = std::enable_if_t<std::is_arithmetic_v<U>>>
+Dual<T, N> pow(U a, const Dual<T, N>& exp) {
+    auto kernel = [b = static_cast<T>(a)](T x) {
+        T value = std::pow(b, x);
+        return kernels::ValueDeriv<T>{value, std::log(b) * value};
+    };
+    return detail_::dual_kernel(kernel, exp);
+}
+
+/** @brief Arc tangent of the quotient of two dual numbers
+ *
+ *  @param y The numerator
+ *  @param x The denominator
+ *
+ *  @return The arc tangent of @p y / @p x, in the quadrant of (x, y)
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> atan2(const Dual<T, N>& y, const Dual<T, N>& x) {
+    T r2 = x.value() * x.value() + y.value() * y.value();
+    return detail_::dual_binary(std::atan2(y.value(), x.value()),
+                                x.value() / r2, y, -y.value() / r2, x);
+}
+
+/** @brief Hypotenuse of two dual numbers
+ *
+ *  @param a The first side
+ *  @param b The second side
+ *
+ *  @return The square root of the sum of the squares of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N>
+Dual<T, N> hypot(const Dual<T, N>& a, const Dual<T, N>& b) {
+    T h = std::hypot(a.value(), b.value());
+    return detail_::dual_binary(h, a.value() / h, a, b.value() / h, b);
+}
+
+/// @brief Sine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> sin(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Sin{}, a);
+}
+
+/// @brief Cosine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> cos(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Cos{}, a);
+}
+
+/// @brief Tangent of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> tan(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Tan{}, a);
+}
+
+/// @brief Arc sine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> asin(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Asin{}, a);
+}
+
+/// @brief Arc cosine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> acos(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Acos{}, a);
+}
+
+/// @brief Arc tangent of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> atan(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Atan{}, a);
+}
+
+/// @brief Hyperbolic sine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> sinh(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Sinh{}, a);
+}
+
+/// @brief Hyperbolic cosine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> cosh(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Cosh{}, a);
+}
+
+/// @brief Hyperbolic tangent of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> tanh(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Tanh{}, a);
+}
+
+/// @brief Inverse hyperbolic sine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> asinh(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Asinh{}, a);
+}
+
+/// @brief Inverse hyperbolic cosine of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> acosh(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Acosh{}, a);
+}
+
+/// @brief Inverse hyperbolic tangent of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> atanh(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Atanh{}, a);
+}
+
+/// @brief Square root of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> sqrt(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Sqrt{}, a);
+}
+
+/// @brief Cube root of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> cbrt(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Cbrt{}, a);
+}
+
+/// @brief Exponential of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> exp(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Exp{}, a);
+}
+
+/// @brief Base 2 exponential of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> exp2(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Exp2{}, a);
+}
+
+/// @brief Exponential minus one of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> expm1(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Expm1{}, a);
+}
+
+/// @brief Natural logarithm of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> log(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Log{}, a);
+}
+
+/// @brief Base 10 logarithm of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> log10(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Log10{}, a);
+}
+
+/// @brief Base 2 logarithm of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> log2(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Log2{}, a);
+}
+
+/// @brief Natural logarithm of one plus a dual number
+template<typename T, std::size_t N>
+Dual<T, N> log1p(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Log1p{}, a);
+}
+
+/// @brief Error function of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> erf(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Erf{}, a);
+}
+
+/// @brief Complementary error function of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> erfc(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Erfc{}, a);
+}
+
+/// @brief Gamma function of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> tgamma(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Tgamma{}, a);
+}
+
+/// @brief Natural logarithm of the gamma function of a dual number
+template<typename T, std::size_t N>
+Dual<T, N> lgamma(const Dual<T, N>& a) {
+    return detail_::dual_kernel(kernels::Lgamma{}, a);
+}
+
+} // namespace sigma
@@ -5,14 +5,10 @@
  */
 
 #ifdef ENABLE_EIGEN_SUPPORT
+#include "sigma/dual.hpp"
+#include "sigma/uncertain.hpp"
 #include <Eigen/Dense>
 
-// Foward Declaration
-namespace sigma {
-template<typename T>
-class Uncertain;
-} // namespace sigma
-
 /** @def EIGEN_NUMTRAITS(float_type)
  *  @brief Factorization for Eigen::NumTraits Specialization
  */
@@ -44,13 +40,42 @@ class Uncertain;
 /** @namespace Eigen
  *  @brief The namespace of the Eigen library
  *
- *  Used here to overload the numeric traits struct for Uncertain values
+ *  Used here to overload the numeric traits struct for Uncertain values and
+ *  dual numbers
  */
 namespace Eigen {
 
 EIGEN_NUMTRAITS(float);
 EIGEN_NUMTRAITS(double);
 
+/** @brief Numeric traits for Dual<T, N>
+ *
+ *  Lets sigma::find_root() pass the unknowns to the function as an Eigen
+ *  vector of dual numbers.
+ */
+template<typename T, std::size_t N>
+struct NumTraits<sigma::Dual<T, N>> : NumTraits<T> {
+    /** The dual number type */
+    using Dual = sigma::Dual<T, N>;
+    /** The corresponding real type */
+    using Real = Dual;
+    /** The corresponding non-integer type */
+    using NonInteger = Dual;
+    /** The corresponding literal type */
+    using Literal = Dual;
+    /** The corresponding nested type */
+    using Nested = Dual;
+    enum {
+        IsComplex             = 0,
+        IsInteger             = 0,
+        IsSigned              = 1,
+        RequireInitialization = 1,
+        ReadCost              = 1,
+        AddCost               = 1 + N,
+        MulCost               = 1 + 2 * N
+    };
+};
+
 } // namespace Eigen
 
 #undef EIGEN_NUMTRAITS
@@ -0,0 +1,649 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/uncertain.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/** @file expression.hpp
+ *  @brief Expression templates for fused arithmetic on uncertain variables
+ */
+
+namespace sigma {
+
+/** @brief Base class of the arithmetic expressions on uncertain variables
+ *
+ *  Arithmetic on expressions only computes the mean of each step; the
+ *  operations are recorded in a tree of expression types. When the tree is
+ *  converted to an Uncertain, it is walked once to find the partial
+ *  derivative of the result with respect to each variable it refers to,
+ *  and the dependencies of those variables are combined with a single k-way
+ *  merge. None of the intermediate Uncertain, nor their dependencies, are
+ *  ever created. The leaves of the tree are found at compile time, so the
+ *  walk does not allocate either.
+ *
+ *  Expressions are started with lazy(). They refer to the variables they
+ *  are built from, so they are meant to be converted within the statement
+ *  building them, not kept with `auto`.
+ *
+ *  @tparam Derived The type of the expression
+ */
+template<typename Derived>
+class Expression {
+public:
+    /** @brief The expression as its derived type
+     *
+     *  @return This instance, cast to @p Derived
+     *
+     *  @throw none No throw guarantee
+     */
+    const Derived& derived() const noexcept {
+        return static_cast<const Derived&>(*this);
+    }
+
+    /** @brief Evaluate the expression
+     *
+     *  @return The variable the expression evaluates to
+     *
+     *  @throw std::bad_alloc if allocating the dependencies fails. Strong
+     *         throw guarantee.
+     */
+    auto evaluate() const;
+
+    /** @brief Evaluate the expression into a variable
+     *
+     *  @tparam T The value type of the variable
+     *  @tparam D The dependency storage type of the variable
+     *
+     *  @return The variable the expression evaluates to
+     *
+     *  @throw std::bad_alloc if allocating the dependencies fails. Strong
+     *         throw guarantee.
+     */
+    template<typename T, typename D>
+    operator Uncertain<T, D>() const;
+};
+
+namespace detail_ {
+
+/** @brief Whether a type is an expression
+ *
+ *  @tparam T The type to check
+ */
+template<typename T>
+inline constexpr bool is_expression_v =
+  std::is_base_of_v<Expression<T>, T>;
+
+/** @brief Whether a type can be an operand of an expression
+ *
+ *  @tparam T The type to check
+ */
+template<typename T>
+inline constexpr bool is_operand_v = is_expression_v<T> ||
+                                     is_uncertain<T>::value ||
+                                     std::is_arithmetic_v<T>;
+
+/** @brief Enabled for the operands of an arithmetic operation that builds
+ *         an expression
+ *
+ *  At least one of the operands has to be an expression already, so the
+ *  eager operations on Uncertain are left alone.
+ *
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ */
+template<typename L, typename R>
+using enable_if_expression_t =
+  std::enable_if_t<(is_expression_v<L> || is_expression_v<R>) &&
+                   is_operand_v<L> && is_operand_v<R>>;
+
+/** @brief Collects the partial derivatives of an expression with respect to
+ *         its variables
+ *
+ *  Variables appearing several times in the expression are given a single
+ *  entry, holding the sum of their partial derivatives.
+ *
+ *  @tparam DepsType The dependency storage type of the variables
+ *  @tparam N The number of leaves of the expression
+ */
+template<typename DepsType, std::size_t N>
+class LeafSink {
+public:
+    /// The type of the partial derivatives
+    using deriv_t = typename DepsType::mapped_type;
+
+    /// The type of a (dependencies, partial derivative) term
+    using value_type = std::pair<const DepsType*, deriv_t>;
+
+    /** @brief Add the partial derivative with respect to a variable
+     *
+     *  @param deps The dependencies of the variable
+     *  @param deriv The partial derivative with respect to the variable
+     *
+     *  @throw none No throw guarantee
+     */
+    void add(const DepsType& deps, deriv_t deriv) noexcept {
+        for(std::size_t i = 0; i < m_size_; ++i) {
+            if(m_terms_[i].first == &deps) {
+                m_terms_[i].second += deriv;
+                return;
+            }
+        }
+        m_terms_[m_size_++] = value_type{&deps, deriv};
+    }
+
+    /// @brief The first of the collected terms
+    const value_type* begin() const noexcept { return m_terms_.data(); }
+
+    /// @brief Just past the last of the collected terms
+    const value_type* end() const noexcept {
+        return m_terms_.data() + m_size_;
+    }
+
+private:
+    /// The collected terms
+    std::array<value_type, N> m_terms_ = {};
+
+    /// The number of collected terms
+    std::size_t m_size_ = 0;
+};
+
+/** @brief An expression that is a variable
+ *
+ *  @tparam UncertainType The type of the variable
+ */
+template<typename UncertainType>
+class LeafExpr : public Expression<LeafExpr<UncertainType>> {
+public:
+    /// The type of the variables in the expression
+    using uncertain_t = UncertainType;
+
+    /// The numeric type of the expression
+    using value_t = typename uncertain_t::value_t;
+
+    /// The number of leaves in the expression
+    static constexpr std::size_t num_leaves = 1;
+
+    /** @brief Wrap a variable
+     *
+     *  @param x The variable, which must outlive the expression
+     *
+     *  @throw none No throw guarantee
+     */
+    explicit LeafExpr(const uncertain_t& x) noexcept : m_x_(&x) {}
+
+    /// @brief The mean value of the expression
+    value_t mean() const noexcept { return m_x_->mean(); }
+
+    /** @brief Collect the partial derivatives of the expression
+     *
+     *  @param adjoint The partial derivative of the result with respect to
+     *                 this expression
+     *  @param sink Where the partial derivatives are collected
+     *
+     *  @throw none No throw guarantee
+     */
+    template<typename Sink>
+    void gather(value_t adjoint, Sink& sink) const noexcept {
+        using deriv_t = typename uncertain_t::deps_map_t::mapped_type;
+        if(adjoint != value_t{0.0}) {
+            sink.add(m_x_->deps(), static_cast<deriv_t>(adjoint));
+        }
+    }
+
+private:
+    /// The variable
+    const uncertain_t* m_x_;
+};
+
+/** @brief An expression that is a certain value
+ *
+ *  @tparam UncertainType The type of the variables in the expression
+ */
+template<typename UncertainType>
+class ConstantExpr : public Expression<ConstantExpr<UncertainType>> {
+public:
+    /// The type of the variables in the expression
+    using uncertain_t = UncertainType;
+
+    /// The numeric type of the expression
+    using value_t = typename uncertain_t::value_t;
+
+    /// The number of leaves in the expression
+    static constexpr std::size_t num_leaves = 0;
+
+    /** @brief Wrap a value
+     *
+     *  @param value The value
+     *
+     *  @throw none No throw guarantee
+     */
+    explicit ConstantExpr(value_t value) noexcept : m_value_(value) {}
+
+    /// @brief The mean value of the expression
+    value_t mean() const noexcept { return m_value_; }
+
+    /// @brief A certain value has no partial derivatives to collect
+    template<typename Sink>
+    void gather(value_t, Sink&) const noexcept {}
+
+private:
+    /// The value
+    value_t m_value_;
+};
+
+/// The negation of an expression
+struct NegateOp {
+    /// @brief The value of the operation
+    template<typename T>
+    static T mean(T a) {
+        return -a;
+    }
+    /// @brief The derivative with respect to the operand
+    template<typename T>
+    static T deriv(T) {
+        return -1.0;
+    }
+};
+
+/// The sum of two expressions
+struct AddOp {
+    /// @brief The value of the operation
+    template<typename T>
+    static T mean(T a, T b) {
+        return a + b;
+    }
+    /// @brief The derivative with respect to the left-hand operand
+    template<typename T>
+    static T lhs_deriv(T, T) {
+        return 1.0;
+    }
+    /// @brief The derivative with respect to the right-hand operand
+    template<typename T>
+    static T rhs_deriv(T, T) {
+        return 1.0;
+    }
+};
+
+/// The difference of two expressions
+struct SubtractOp {
+    /// @brief The value of the operation
+    template<typename T>
+    static T mean(T a, T b) {
+        return a - b;
+    }
+    /// @brief The derivative with respect to the left-hand operand
+    template<typename T>
+    static T lhs_deriv(T, T) {
+        return 1.0;
+    }
+    /// @brief The derivative with respect to the right-hand operand
+    template<typename T>
+    static T rhs_deriv(T, T) {
+        return -1.0;
+    }
+};
+
+/// The product of two expressions
+struct MultiplyOp {
+    /// @brief The value of the operation
+    template<typename T>
+    static T mean(T a, T b) {
+        return a * b;
+    }
+    /// @brief The derivative with respect to the left-hand operand
+    template<typename T>
+    static T lhs_deriv(T, T b) {
+        return b;
+    }
+    /// @brief The derivative with respect to the right-hand operand
+    template<typename T>
+    static T rhs_deriv(T a, T) {
+        return a;
+    }
+};
+
+/// The quotient of two expressions
+struct DivideOp {
+    /// @brief The value of the operation
+    template<typename T>
+    static T mean(T a, T b) {
+        return a / b;
+    }
+    /// @brief The derivative with respect to the left-hand operand
+    template<typename T>
+    static T lhs_deriv(T, T b) {
+        return 1.0 / b;
+    }
+    /// @brief The derivative with respect to the right-hand operand
+    template<typename T>
+    static T rhs_deriv(T a, T b) {
+        return -a / std::pow(b, 2.0);
+    }
+};
+
+/** @brief An expression applying a unary operation to another
+ *
+ *  @tparam Op The operation
+ *  @tparam E The type of the operand
+ */
+template<typename Op, typename E>
+class UnaryExpr : public Expression<UnaryExpr<Op, E>> {
+public:
+    /// The type of the variables in the expression
+    using uncertain_t = typename E::uncertain_t;
+
+    /// The numeric type of the expression
+    using value_t = typename uncertain_t::value_t;
+
+    /// The number of leaves in the expression
+    static constexpr std::size_t num_leaves = E::num_leaves;
+
+    /** @brief Apply the operation to an expression
+     *
+     *  @param a The operand
+     *
+     *  @throw none No throw guarantee
+     */
+    explicit UnaryExpr(const E& a) : m_a_(a), m_mean_(Op::mean(a.mean())) {}
+
+    /// @brief The mean value of the expression
+    value_t mean() const noexcept { return m_mean_; }
+
+    /** @brief Collect the partial derivatives of the expression
+     *
+     *  @param adjoint The partial derivative of the result with respect to
+     *                 this expression
+     *  @param sink Where the partial derivatives are collected
+     *
+     *  @throw none No throw guarantee
+     */
+    template<typename Sink>
+    void gather(value_t adjoint, Sink& sink) const {
+        m_a_.gather(adjoint * Op::deriv(m_a_.mean()), sink);
+    }
+
+private:
+    /// The operand
+    E m_a_;
+
+    /// The mean value of the expression
+    value_t m_mean_;
+};
+
+/** @brief An expression applying a binary operation to two others
+ *
+ *  @tparam Op The operation
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ */
+template<typename Op, typename L, typename R>
+class BinaryExpr : public Expression<BinaryExpr<Op, L, R>> {
+public:
+    /// The type of the variables in the expression
+    using uncertain_t = typename L::uncertain_t;
+
+    /// The numeric type of the expression
+    using value_t = typename uncertain_t::value_t;
+
+    /// The number of leaves in the expression
+    static constexpr std::size_t num_leaves = L::num_leaves + R::num_leaves;
+
+    static_assert(std::is_same_v<uncertain_t, typename R::uncertain_t>,
+                  "Expressions can only combine one type of variable");
+
+    /** @brief Apply the operation to two expressions
+     *
+     *  @param lhs The left-hand operand
+     *  @param rhs The right-hand operand
+     *
+     *  @throw none No throw guarantee
+     */
+    BinaryExpr(const L& lhs, const R& rhs) :
+      m_lhs_(lhs), m_rhs_(rhs), m_mean_(Op::mean(lhs.mean(), rhs.mean())) {}
+
+    /// @brief The mean value of the expression
+    value_t mean() const noexcept { return m_mean_; }
+
+    /** @brief Collect the partial derivatives of the expression
+     *
+     *  @param adjoint The partial derivative of the result with respect to
+     *                 this expression
+     *  @param sink Where the partial derivatives are collected
+     *
+     *  @throw none No throw guarantee
+     */
+    template<typename Sink>
+    void gather(value_t adjoint, Sink& sink) const {
+        auto a = m_lhs_.mean();
+        auto b = m_rhs_.mean();
+        m_lhs_.gather(adjoint * Op::lhs_deriv(a, b), sink);
+        m_rhs_.gather(adjoint * Op::rhs_deriv(a, b), sink);
+    }
+
+private:
+    /// The left-hand operand
+    L m_lhs_;
+
+    /// The right-hand operand
+    R m_rhs_;
+
+    /// The mean value of the expression
+    value_t m_mean_;
+};
+
+/** @brief The type of the variables in an operand of an expression
+ *
+ *  @tparam T The type of the operand
+ */
+template<typename T, typename = void>
+struct operand_uncertain {
+    /// Arithmetic values take the type of the other operand
+    using type = void;
+};
+
+/// @brief Specialization for expressions
+template<typename T>
+struct operand_uncertain<T, std::enable_if_t<is_expression_v<T>>> {
+    /// The type of the variables in the expression
+    using type = typename T::uncertain_t;
+};
+
+/// @brief Specialization for Uncertain
+template<typename T>
+struct operand_uncertain<T, std::enable_if_t<is_uncertain<T>::value>> {
+    /// The variable itself
+    using type = T;
+};
+
+/** @brief Turn an operand into an expression
+ *
+ *  @tparam UncertainType The type of the variables in the expression
+ *  @tparam T The type of the operand
+ *  @param x The operand
+ *
+ *  @return @p x as an expression
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename UncertainType, typename T>
+auto as_expression(const T& x) {
+    if constexpr(is_expression_v<T>) {
+        return x;
+    } else if constexpr(is_uncertain<T>::value) {
+        return LeafExpr<T>(x);
+    } else {
+        using value_t = typename UncertainType::value_t;
+        return ConstantExpr<UncertainType>(static_cast<value_t>(x));
+    }
+}
+
+/** @brief Build the expression applying a binary operation to two operands
+ *
+ *  @tparam Op The operation
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ *  @param lhs The left-hand operand
+ *  @param rhs The right-hand operand
+ *
+ *  @return The expression
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Op, typename L, typename R>
+auto make_binary_expr(const L& lhs, const R& rhs) {
+    using lhs_t = typename operand_uncertain<L>::type;
+    using rhs_t = typename operand_uncertain<R>::type;
+    using uncertain_t =
+      std::conditional_t<std::is_void_v<lhs_t>, rhs_t, lhs_t>;
+    auto l = as_expression<uncertain_t>(lhs);
+    auto r = as_expression<uncertain_t>(rhs);
+    return BinaryExpr<Op, decltype(l), decltype(r)>(l, r);
+}
+
+} // namespace detail_
+
+/** @brief Start an expression from a variable
+ *
+ *  Arithmetic involving the result builds an expression, which is only
+ *  evaluated when it is converted to an Uncertain (see Expression).
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
+ *  @param x The variable, which must outlive the expression
+ *
+ *  @return An expression that is @p x
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename D>
+detail_::LeafExpr<Uncertain<T, D>> lazy(const Uncertain<T, D>& x) {
+    return detail_::LeafExpr<Uncertain<T, D>>(x);
+}
+
+/** @relates Expression
+ *  @brief Negation of an expression
+ *
+ *  @tparam E The type of the expression
+ *  @param a The expression being negated
+ *
+ *  @return An expression that is the negation of @p a
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename E>
+auto operator-(const Expression<E>& a) {
+    return detail_::UnaryExpr<detail_::NegateOp, E>(a.derived());
+}
+
+/** @relates Expression
+ *  @brief Addition involving an expression
+ *
+ *  The other operand may be an expression, an Uncertain or a certain value.
+ *
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ *  @param lhs The left-hand operand
+ *  @param rhs The right-hand operand
+ *
+ *  @return An expression that is the sum of @p lhs and @p rhs
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         typename = detail_::enable_if_expression_t<L, R>>
+auto operator+(const L& lhs, const R& rhs) {
+    return detail_::make_binary_expr<detail_::AddOp>(lhs, rhs);
+}
+
+/** @relates Expression
+ *  @brief Subtraction involving an expression
+ *
+ *  The other operand may be an expression, an Uncertain or a certain value.
+ *
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ *  @param lhs The left-hand operand
+ *  @param rhs The right-hand operand
+ *
+ *  @return An expression that is the difference of @p lhs and @p rhs
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         typename = detail_::enable_if_expression_t<L, R>>
+auto operator-(const L& lhs, const R& rhs) {
+    return detail_::make_binary_expr<detail_::SubtractOp>(lhs, rhs);
+}
+
+/** @relates Expression
+ *  @brief Multiplication involving an expression
+ *
+ *  The other operand may be an expression, an Uncertain or a certain value.
+ *
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ *  @param lhs The left-hand operand
+ *  @param rhs The right-hand operand
+ *
+ *  @return An expression that is the product of @p lhs and @p rhs
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         typename = detail_::enable_if_expression_t<L, R>>
+auto operator*(const L& lhs, const R& rhs) {
+    return detail_::make_binary_expr<detail_::MultiplyOp>(lhs, rhs);
+}
+
+/** @relates Expression
+ *  @brief Division involving an expression
+ *
+ *  The other operand may be an expression, an Uncertain or a certain value.
+ *
+ *  @tparam L The type of the left-hand operand
+ *  @tparam R The type of the right-hand operand
+ *  @param lhs The left-hand operand
+ *  @param rhs The right-hand operand
+ *
+ *  @return An expression that is the quotient of @p lhs and @p rhs
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         typename = detail_::enable_if_expression_t<L, R>>
+auto operator/(const L& lhs, const R& rhs) {
+    return detail_::make_binary_expr<detail_::DivideOp>(lhs, rhs);
+}
+
+// -- Out-of-line Definitions --------------------------------------------------
+
+template<typename Derived>
+auto Expression<Derived>::evaluate() const {
+    using uncertain_t = typename Derived::uncertain_t;
+    using deps_map_t  = typename uncertain_t::deps_map_t;
+    const auto& expr  = derived();
+
+    detail_::LeafSink<deps_map_t, Derived::num_leaves> sink;
+    expr.gather(typename uncertain_t::value_t{1.0}, sink);
+
+    uncertain_t result(expr.mean());
+    detail_::Setter<uncertain_t> result_setter(result);
+    result_setter.set_derivatives(
+      detail_::linear_combination(sink.begin(), sink.end()));
+    return result;
+}
+
+template<typename Derived>
+template<typename T, typename D>
+Expression<Derived>::operator Uncertain<T, D>() const {
+    static_assert(
+      std::is_same_v<Uncertain<T, D>, typename Derived::uncertain_t>,
+      "Expressions can only be converted to the type of their variables");
+    return evaluate();
+}
+
+} // namespace sigma
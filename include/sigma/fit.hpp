@@ -0,0 +1,231 @@
+#pragma once
+
+/** @file fit.hpp
+ *  @brief Least-squares fitting of models to uncertain data
+ *
+ *  The fit runs on the mean values of the data in plain Eigen arithmetic,
+ *  and the dependencies of the fitted parameters are only attached at the
+ *  end, from the sensitivity of the solution to the data. This is far
+ *  cheaper than pushing uncertain values through the decompositions.
+ */
+
+#ifdef ENABLE_EIGEN_SUPPORT
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/dual.hpp"
+#include "sigma/eigen_compat.hpp"
+#include "sigma/memory_resource.hpp"
+#include "sigma/operations/reductions.hpp"
+#include "sigma/uncertain.hpp"
+#include <Eigen/Dense>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace sigma {
+namespace detail_ {
+
+/// The maximum number of iterations of fit()
+constexpr std::size_t max_fit_iterations = 200;
+
+/** @brief The residuals of a model and their derivatives
+ *
+ *  @tparam T The numeric type
+ *  @tparam P The number of parameters
+ */
+template<typename T, int P>
+struct Linearization {
+    /// The weighted residuals, sqrt(w_i) (y_i - f(x_i, p))
+    Eigen::Matrix<T, Eigen::Dynamic, 1> residuals;
+
+    /// The weighted Jacobian of the model with respect to the parameters
+    Eigen::Matrix<T, Eigen::Dynamic, P> jacobian;
+
+    /// The derivative of the model with respect to x at each point
+    Eigen::Matrix<T, Eigen::Dynamic, 1> slopes;
+
+    /** @brief The weighted sum of the squares of the residuals
+     *
+     *  @return The quantity the fit minimizes
+     *
+     *  @throw none No throw guarantee
+     */
+    T chi2() const { return residuals.squaredNorm(); }
+};
+
+/** @brief Linearize a model around some parameters
+ *
+ *  @tparam T The numeric type
+ *  @tparam P The number of parameters
+ *  @tparam ModelType The type of the model
+ *  @param model The model
+ *  @param p The parameters
+ *  @param x The mean values of the independent variable
+ *  @param y The mean values of the data
+ *  @param sqrt_w The square roots of the weights of the data
+ *  @param lin Set to the linearization at @p p
+ *
+ *  @throw ... Any exception thrown by the model
+ */
+template<typename T, int P, typename ModelType>
+void linearize(ModelType& model, const Eigen::Matrix<T, P, 1>& p,
+               const Eigen::Matrix<T, Eigen::Dynamic, 1>& x,
+               const Eigen::Matrix<T, Eigen::Dynamic, 1>& y,
+               const Eigen::Matrix<T, Eigen::Dynamic, 1>& sqrt_w,
+               Linearization<T, P>& lin) {
+    // The last variable is x, for the sensitivity to uncertain x values
+    using dual_t = Dual<T, P + 1>;
+    Eigen::Matrix<dual_t, P, 1> pd;
+    for(int j = 0; j < P; ++j) pd(j) = dual_t::variable(p(j), j);
+
+    auto n = x.size();
+    lin.residuals.resize(n);
+    lin.jacobian.resize(n, P);
+    lin.slopes.resize(n);
+    for(Eigen::Index i = 0; i < n; ++i) {
+        dual_t f         = model(dual_t::variable(x(i), P), pd);
+        lin.residuals(i) = sqrt_w(i) * (y(i) - f.value());
+        lin.slopes(i)    = f.derivative(P);
+        for(int j = 0; j < P; ++j) {
+            lin.jacobian(i, j) = sqrt_w(i) * f.derivative(j);
+        }
+    }
+}
+
+} // namespace detail_
+
+/** @brief Fit a model to uncertain data by least squares
+ *
+ *  Finds the parameters p minimizing sum_i w_i (y_i - model(x_i, p))^2 by
+ *  the Levenberg-Marquardt method, on the mean values of the data. The
+ *  weights are 1 / sd(y_i)^2, or all 1 if any of the data is exact. The
+ *  fitted parameters depend on the sources of the data through the
+ *  sensitivity of the solution to the data, dp/dy = (J^T W J)^-1 J^T W,
+ *  which is exact for models linear in their parameters and the usual
+ *  linearization otherwise, and, if the x values are uncertain as well,
+ *  dp/dx_i = -dp/dy_i df/dx(x_i). Parameters fitted to the same data are
+ *  therefore correlated.
+ *
+ *  The model is called as `model(x, p)`, with x a dual number and p an
+ *  Eigen vector of them, and so, as for sigma::lift(), must be generic.
+ *
+ *  @code
+ *  auto decay = [](auto x, const auto& p) {
+ *      using std::exp;
+ *      return p(0) * exp(-p(1) * x);
+ *  };
+ *  auto p = sigma::fit(decay, t, counts, Eigen::Vector2d(100.0, 0.1));
+ *  @endcode
+ *
+ *  @tparam ModelType The type of the model
+ *  @tparam XRange The type of the range of x values, plain numbers or
+ *                 uncertain variables
+ *  @tparam YRange The type of the range of data
+ *  @tparam P The number of parameters, known at compile time
+ *  @param model The model
+ *  @param x The independent variable at each data point
+ *  @param y The data
+ *  @param p0 The initial guess for the parameters
+ *
+ *  @return The fitted parameters
+ *
+ *  @throw std::invalid_argument if @p x and @p y differ in size or there
+ *         are fewer points than parameters. Strong throw guarantee.
+ *  @throw std::runtime_error if the fit does not converge, or if the
+ *         model does not depend on some combination of the parameters at
+ *         the fitted values. Strong throw guarantee.
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename ModelType, typename XRange, typename YRange, int P>
+Eigen::Matrix<detail_::uncertain_range_t<YRange>, P, 1> fit(
+  ModelType model, const XRange& x, const YRange& y,
+  const Eigen::Matrix<typename detail_::uncertain_range_t<YRange>::value_t, P,
+                      1>& p0) {
+    static_assert(P != Eigen::Dynamic,
+                  "The number of parameters must be known at compile time");
+    using uncertain_t = detail_::uncertain_range_t<YRange>;
+    using value_t     = typename uncertain_t::value_t;
+    using vector_t    = Eigen::Matrix<value_t, Eigen::Dynamic, 1>;
+    using params_t    = Eigen::Matrix<value_t, P, 1>;
+    using matrix_t    = Eigen::Matrix<value_t, P, P>;
+
+    auto n = detail_::common_size(x, y);
+    if(n < static_cast<std::size_t>(P)) {
+        throw std::invalid_argument("fit: fewer data points than parameters");
+    }
+
+    vector_t x_mean(n), y_mean(n), sqrt_w(n);
+    bool weighted = true;
+    auto xi       = std::begin(x);
+    auto yi       = std::begin(y);
+    for(std::size_t i = 0; i < n; ++i, ++xi, ++yi) {
+        x_mean(i) = detail_::mean_of(*xi);
+        y_mean(i) = yi->mean();
+        sqrt_w(i) = value_t{1} / yi->sd();
+        weighted  = weighted && std::isfinite(sqrt_w(i));
+    }
+    if(!weighted) sqrt_w.setOnes();
+
+    // Levenberg-Marquardt, with Marquardt's scaling of the damping
+    const auto tol = std::sqrt(std::numeric_limits<value_t>::epsilon());
+    params_t p     = p0;
+    detail_::Linearization<value_t, P> lin, trial;
+    detail_::linearize(model, p, x_mean, y_mean, sqrt_w, lin);
+    value_t lambda = 1.0e-3;
+    bool converged = false;
+    for(std::size_t i = 0; i < detail_::max_fit_iterations; ++i) {
+        matrix_t a = lin.jacobian.transpose() * lin.jacobian;
+        params_t g = lin.jacobian.transpose() * lin.residuals;
+        a.diagonal() *= (1 + lambda);
+        params_t step  = a.ldlt().solve(g);
+        params_t p_new = p + step;
+        detail_::linearize(model, p_new, x_mean, y_mean, sqrt_w, trial);
+        if(std::isfinite(trial.chi2()) && trial.chi2() <= lin.chi2()) {
+            converged = step.norm() <= tol * (p.norm() + tol) ||
+                        lin.chi2() - trial.chi2() <= tol * tol * lin.chi2();
+            p = p_new;
+            std::swap(lin, trial);
+            lambda /= 10;
+        } else if(lambda > 1.0e10) {
+            // No step decreases chi2 any further, which is only a minimum
+            // if the gradient vanishes there
+            converged = g.norm() <= tol * (lin.chi2() + tol);
+            break;
+        } else {
+            lambda *= 10;
+        }
+        if(converged) break;
+    }
+    if(!converged) throw std::runtime_error("fit: did not converge");
+
+    // Sensitivity of the parameters to the data, which only exists if the
+    // data determine all of the parameters
+    matrix_t a = lin.jacobian.transpose() * lin.jacobian;
+    Eigen::FullPivLU<matrix_t> lu(a);
+    if(!lu.isInvertible()) {
+        throw std::runtime_error(
+          "fit: the data do not determine all of the parameters");
+    }
+    Eigen::Matrix<value_t, P, Eigen::Dynamic> dpdy =
+      lu.solve(lin.jacobian.transpose() * sqrt_w.asDiagonal());
+
+    Eigen::Matrix<uncertain_t, P, 1> result;
+    for(int j = 0; j < P; ++j) {
+        detail_::reduction_operands_t<uncertain_t> operands(
+          sigma::get_memory_resource());
+        operands.reserve(2 * n);
+        xi = std::begin(x);
+        yi = std::begin(y);
+        for(std::size_t i = 0; i < n; ++i, ++xi, ++yi) {
+            detail_::add_operand(operands, *yi, dpdy(j, i));
+            detail_::add_operand(operands, *xi, -dpdy(j, i) * lin.slopes(i));
+        }
+        result(j) = detail_::nary_result(p(j), operands);
+    }
+    return result;
+}
+
+} // namespace sigma
+#endif // ENABLE_EIGEN_SUPPORT
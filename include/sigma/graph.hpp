@@ -0,0 +1,336 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/memory_resource.hpp"
+#include "sigma/tape.hpp"
+#include "sigma/uncertain.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/** @file graph.hpp
+ *  @brief Parallel evaluation of the computation recorded on a Tape
+ *
+ *  The records on a Tape form a directed acyclic graph, in topological
+ *  order. Rather than sweeping backwards over it, as Tape::evaluate() does,
+ *  sigma::evaluate() forms the dependencies of each node the outputs need
+ *  from those of its operands, as the eager operations would, but schedules
+ *  the nodes on a pool of threads, so that independent branches of the
+ *  computation are merged in parallel.
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/// A queue of tasks owned by one worker, from which the others steal
+struct WorkQueue {
+    /// Guards the tasks
+    std::mutex mutex;
+
+    /// The tasks, the owner working at the back and thieves at the front
+    std::deque<std::uint32_t> tasks;
+};
+
+/** @brief Run the tasks of a directed acyclic graph on a pool of threads
+ *
+ *  A task is ready once all of the tasks it depends on have run. Each
+ *  worker runs the ready tasks from its own queue, most recent first, and
+ *  pushes the tasks they make ready onto it, so that a branch of the graph
+ *  tends to stay on one thread; a worker whose queue is empty steals the
+ *  oldest task from another's. Workers that find no task at all sleep until
+ *  one is pushed or the graph is done. The calling thread is one of the
+ *  workers. Every worker allocates from @p resource while it runs tasks.
+ *
+ *  @tparam TaskType The type of @p task
+ *  @param pending The number of tasks each task depends on
+ *  @param offsets Offsets into @p dependents, one more than there are tasks
+ *  @param dependents The tasks depending on task i, starting at offsets[i]
+ *  @param task Runs the task with the given index
+ *  @param n_threads The number of workers
+ *  @param resource The memory resource of the workers, null for the
+ *                  default one
+ *
+ *  @throw ... Rethrows the first exception thrown by @p task, or by
+ *         starting a thread, after all of the workers have stopped.
+ */
+template<typename TaskType>
+void run_graph(const std::vector<std::uint32_t>& pending,
+               const std::vector<std::uint32_t>& offsets,
+               const std::vector<std::uint32_t>& dependents, TaskType& task,
+               std::size_t n_threads, std::pmr::memory_resource* resource) {
+    auto n_tasks = pending.size();
+    std::unique_ptr<std::atomic<std::uint32_t>[]> counts(
+      new std::atomic<std::uint32_t>[n_tasks]);
+    std::unique_ptr<WorkQueue[]> queues(new WorkQueue[n_threads]);
+    std::size_t n_ready = 0;
+    for(std::size_t i = 0; i < n_tasks; ++i) {
+        counts[i].store(pending[i]);
+        if(pending[i] == 0) {
+            queues[n_ready++ % n_threads].tasks.push_back(i);
+        }
+    }
+
+    // Tasks sitting in the queues, and the workers waiting for one
+    std::atomic<std::size_t> queued{n_ready};
+    std::atomic<std::size_t> sleeping{0};
+    std::mutex idle_mutex;
+    std::condition_variable idle;
+    auto wake_all = [&]() {
+        std::lock_guard<std::mutex> lock(idle_mutex);
+        idle.notify_all();
+    };
+
+    std::atomic<std::size_t> remaining{n_tasks};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto fail = [&]() {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if(!error) error = std::current_exception();
+            failed = true;
+        }
+        wake_all();
+    };
+
+    auto pop = [&](std::size_t w) -> std::optional<std::uint32_t> {
+        for(std::size_t k = 0; k < n_threads; ++k) {
+            auto& queue = queues[(w + k) % n_threads];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if(queue.tasks.empty()) continue;
+            std::uint32_t t;
+            if(k == 0) {
+                t = queue.tasks.back();
+                queue.tasks.pop_back();
+            } else {
+                t = queue.tasks.front();
+                queue.tasks.pop_front();
+            }
+            --queued;
+            return t;
+        }
+        return std::nullopt;
+    };
+
+    auto push = [&](std::size_t w, std::uint32_t t) {
+        {
+            std::lock_guard<std::mutex> lock(queues[w].mutex);
+            queues[w].tasks.push_back(t);
+        }
+        ++queued;
+        // A worker going to sleep counts itself before checking queued, so
+        // either it sees this task or it is seen here
+        if(sleeping.load() > 0) {
+            std::lock_guard<std::mutex> lock(idle_mutex);
+            idle.notify_one();
+        }
+    };
+
+    auto done = [&]() { return remaining.load() == 0 || failed.load(); };
+
+    auto worker = [&](std::size_t w) {
+        sigma::ScopedMemoryResource scope(resource);
+        while(!done()) {
+            auto t = pop(w);
+            if(!t) {
+                std::unique_lock<std::mutex> lock(idle_mutex);
+                ++sleeping;
+                idle.wait(lock, [&]() { return queued.load() > 0 || done(); });
+                --sleeping;
+                continue;
+            }
+            try {
+                task(*t);
+                for(auto i = offsets[*t]; i < offsets[*t + 1]; ++i) {
+                    auto d = dependents[i];
+                    if(counts[d].fetch_sub(1) == 1) push(w, d);
+                }
+            } catch(...) {
+                fail();
+                return;
+            }
+            if(--remaining == 0) wake_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    try {
+        threads.reserve(n_threads - 1);
+        for(std::size_t w = 1; w < n_threads; ++w) {
+            threads.emplace_back(worker, w);
+        }
+    } catch(...) {
+        fail();
+    }
+    worker(0);
+    for(auto& thread : threads) thread.join();
+    if(error) std::rethrow_exception(error);
+}
+
+} // namespace detail_
+
+/** @brief Evaluate results computed on a tape, in parallel
+ *
+ *  Only the nodes of the tape that the outputs depend on are evaluated.
+ *  The dependencies of each node are formed with a single merge of those
+ *  of its operands, and released as soon as the nodes using them are done,
+ *  unless they are one of the outputs. Independent nodes are evaluated on
+ *  different threads, by work stealing.
+ *
+ *  This does the same merges as the eager operations, just in parallel,
+ *  while Tape::evaluate() sweeps the tape once per output and merges once
+ *  at the end, which is usually cheaper for a few outputs of a long serial
+ *  computation.
+ *
+ *  Dependencies formed by one thread may be released by another, so all
+ *  of the threads, the calling one included, allocate from @p resource
+ *  while the graph is evaluated, rather than from their own (see
+ *  sigma::get_memory_resource()). It must be thread-safe, like the
+ *  default resource or a std::pmr::synchronized_pool_resource, and
+ *  outlive the results, whose dependencies are allocated from it.
+ *
+ *  @tparam UncertainType The type of the variables on the tape
+ *  @tparam Outputs The type of the range of outputs
+ *  @param tape The tape
+ *  @param outputs The results to evaluate, variables on @p tape
+ *  @param n_threads The number of threads to use, including the calling
+ *                   one. If 0, the number of hardware threads. Never more
+ *                   than the largest number of nodes at the same depth of
+ *                   the graph, so a serial computation runs on the calling
+ *                   thread alone.
+ *  @param resource The thread-safe memory resource to allocate the
+ *                  dependencies from. If null, the default resource.
+ *
+ *  @return The Uncertain variable for each of @p outputs
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ *  @throw std::system_error if a thread cannot be started. Strong throw
+ *         guarantee.
+ */
+template<typename UncertainType, typename Outputs>
+std::vector<UncertainType> evaluate(const Tape<UncertainType>& tape,
+                                    const Outputs& outputs,
+                                    std::size_t n_threads = 0,
+                                    std::pmr::memory_resource* resource =
+                                      nullptr) {
+    using uncertain_t = UncertainType;
+    using index_t     = typename Tape<uncertain_t>::index_t;
+    using deps_map_t  = typename uncertain_t::deps_map_t;
+    using deriv_t     = typename deps_map_t::mapped_type;
+    using term_t      = std::pair<const deps_map_t*, deriv_t>;
+    constexpr auto no_parent = Tape<uncertain_t>::no_parent;
+
+    std::vector<uncertain_t> results;
+    if(std::begin(outputs) == std::end(outputs)) return results;
+
+    // The nodes the outputs need
+    std::size_t n = 0;
+    for(const auto& y : outputs) n = std::max<std::size_t>(n, y.index() + 1);
+    std::vector<char> needed(n, 0), pinned(n, 0);
+    for(const auto& y : outputs) needed[y.index()] = pinned[y.index()] = 1;
+    for(std::size_t i = n; i-- > 0;) {
+        if(!needed[i]) continue;
+        for(auto p : tape.record(i).parents) {
+            if(p != no_parent) needed[p] = 1;
+        }
+    }
+
+    // The dependencies of each node: those of the input, or computed by a
+    // task
+    std::vector<const deps_map_t*> deps(n, nullptr);
+    for(const auto& [index, x] : tape.inputs()) {
+        if(index >= n) break;
+        deps[index] = &x.deps();
+    }
+    constexpr auto no_task = Tape<uncertain_t>::no_parent;
+    std::vector<std::uint32_t> task_of(n, no_task), node_of;
+    for(std::size_t i = 0; i < n; ++i) {
+        if(needed[i] && !deps[i]) {
+            task_of[i] = node_of.size();
+            node_of.push_back(i);
+        }
+    }
+    auto n_tasks = node_of.size();
+    std::vector<deps_map_t> storage(n_tasks);
+    for(std::size_t t = 0; t < n_tasks; ++t) deps[node_of[t]] = &storage[t];
+
+    // The graph of the tasks, and the number of tasks using each result
+    // Tasks come in topological order, so the level of each, one more than
+    // that of its deepest operand, is known once its operands are done
+    std::vector<std::uint32_t> pending(n_tasks, 0), offsets(n_tasks + 1, 0);
+    std::vector<std::uint32_t> level(n_tasks, 0);
+    std::vector<std::size_t> width;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> users(
+      new std::atomic<std::uint32_t>[n_tasks]);
+    for(std::size_t t = 0; t < n_tasks; ++t) users[t].store(0);
+    for(std::size_t t = 0; t < n_tasks; ++t) {
+        for(auto p : tape.record(node_of[t]).parents) {
+            if(p == no_parent || task_of[p] == no_task) continue;
+            ++pending[t];
+            ++offsets[task_of[p] + 1];
+            ++users[task_of[p]];
+            level[t] = std::max(level[t], level[task_of[p]] + 1);
+        }
+        if(level[t] >= width.size()) width.resize(level[t] + 1, 0);
+        ++width[level[t]];
+    }
+    for(std::size_t t = 0; t < n_tasks; ++t) offsets[t + 1] += offsets[t];
+    std::vector<std::uint32_t> dependents(offsets.back());
+    std::vector<std::uint32_t> filled(offsets.begin(), offsets.end() - 1);
+    for(std::size_t t = 0; t < n_tasks; ++t) {
+        for(auto p : tape.record(node_of[t]).parents) {
+            if(p == no_parent || task_of[p] == no_task) continue;
+            dependents[filled[task_of[p]]++] = t;
+        }
+    }
+
+    auto task = [&](std::uint32_t t) {
+        const auto& record = tape.record(node_of[t]);
+        term_t terms[2];
+        std::size_t n_terms = 0;
+        for(std::size_t j = 0; j < 2 && record.parents[j] != no_parent; ++j) {
+            terms[n_terms++] = {deps[record.parents[j]],
+                                static_cast<deriv_t>(record.partials[j])};
+        }
+        storage[t] = detail_::linear_combination(terms, terms + n_terms);
+
+        // Release the operands no other node still needs
+        for(std::size_t j = 0; j < n_terms; ++j) {
+            index_t p = record.parents[j];
+            if(task_of[p] == no_task || pinned[p]) continue;
+            if(users[task_of[p]].fetch_sub(1) == 1) {
+                storage[task_of[p]] = deps_map_t{};
+            }
+        }
+    };
+    // No more threads than the widest level of independent tasks can use
+    auto widest = width.empty() ? 1 : *std::max_element(width.begin(),
+                                                        width.end());
+    if(n_threads == 0) n_threads = std::thread::hardware_concurrency();
+    n_threads = std::clamp<std::size_t>(n_threads, 1, widest);
+    detail_::run_graph(pending, offsets, dependents, task, n_threads,
+                       resource);
+
+    results.reserve(std::size(outputs));
+    for(const auto& y : outputs) {
+        uncertain_t c(y.value());
+        detail_::Setter<uncertain_t> c_setter(c);
+        c_setter.set_derivatives(*deps[y.index()]);
+        results.push_back(std::move(c));
+    }
+    return results;
+}
+
+} // namespace sigma
@@ -0,0 +1,436 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/detail_/special_functions.hpp"
+#include "sigma/memory_resource.hpp"
+#include "sigma/uncertain.hpp"
+#include <cmath>
+#include <cstddef>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+/** @file kernels.hpp
+ *  @brief Kernels computing a function and its derivative together
+ */
+
+/** @def SIGMA_SIMD
+ *  @brief Vectorize the loops evaluating kernels over batches of values
+ *
+ *  When defined, the loops in sigma::kernels::evaluate() are marked with
+ *  `#pragma omp simd`, which takes effect with `-fopenmp` or `-fopenmp-simd`.
+ *  The calls to the transcendental functions are only vectorized if the C
+ *  library provides vector versions of them, e.g. glibc's libmvec, which
+ *  GCC uses with `-ffast-math`. Not defined by default.
+ */
+#ifdef SIGMA_SIMD
+#define SIGMA_SIMD_LOOP _Pragma("omp simd")
+#else
+#define SIGMA_SIMD_LOOP
+#endif
+
+/** @namespace sigma::kernels
+ *  @brief The kernels behind the unary operations
+ *
+ *  Each kernel is a function object returning the value of a function and
+ *  its derivative at the same point, sharing the work between the two:
+ *  e.g. the derivative of exp is its value, that of tan is formed from its
+ *  value, and sin and cos of the same argument are left for the compiler to
+ *  fuse into a single sincos. The unary operations on Uncertain are built on
+ *  them, and they can be applied to whole batches of variables with
+ *  sigma::transform().
+ */
+namespace sigma::kernels {
+
+/** @brief The value of a function and its derivative at a point
+ *
+ *  @tparam T The numeric type
+ */
+template<typename T>
+struct ValueDeriv {
+    /// The value of the function
+    T value;
+
+    /// The derivative of the function
+    T deriv;
+};
+
+/** @brief The value of a function of two arguments and its partial
+ *         derivatives at a point
+ *
+ *  @tparam T The numeric type
+ */
+template<typename T>
+struct ValueGrad {
+    /// The value of the function
+    T value;
+
+    /// The partial derivative with respect to the first argument
+    T lhs_deriv;
+
+    /// The partial derivative with respect to the second argument
+    T rhs_deriv;
+};
+
+/// ln(2)
+constexpr double ln2 = 0.693147180559945309417232121458176568;
+
+/// ln(10)
+constexpr double ln10 = 2.30258509299404568401799145468436421;
+
+/// 2 / sqrt(pi), the factor in the derivative of the error function
+constexpr double two_over_sqrt_pi = 1.12837916709551257389615890312154517;
+
+// -- Trigonometry -------------------------------------------------------------
+
+/// Kernel for the sine
+struct Sin {
+    /// @brief The sine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::sin(x), std::cos(x)};
+    }
+};
+
+/// Kernel for the cosine
+struct Cos {
+    /// @brief The cosine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::cos(x), -std::sin(x)};
+    }
+};
+
+/// Kernel for the tangent
+struct Tan {
+    /// @brief The tangent of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T t = std::tan(x);
+        return {t, T{1} + t * t};
+    }
+};
+
+/// Kernel for the arc sine
+struct Asin {
+    /// @brief The arc sine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::asin(x), T{1} / std::sqrt(T{1} - x * x)};
+    }
+};
+
+/// Kernel for the arc cosine
+struct Acos {
+    /// @brief The arc cosine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::acos(x), T{-1} / std::sqrt(T{1} - x * x)};
+    }
+};
+
+/// Kernel for the arc tangent
+struct Atan {
+    /// @brief The arc tangent of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::atan(x), T{1} / (T{1} + x * x)};
+    }
+};
+
+// -- Hyperbolic ---------------------------------------------------------------
+
+/// Kernel for the hyperbolic sine
+struct Sinh {
+    /// @brief The hyperbolic sine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::sinh(x), std::cosh(x)};
+    }
+};
+
+/// Kernel for the hyperbolic cosine
+struct Cosh {
+    /// @brief The hyperbolic cosine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::cosh(x), std::sinh(x)};
+    }
+};
+
+/// Kernel for the hyperbolic tangent
+struct Tanh {
+    /// @brief The hyperbolic tangent of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T t = std::tanh(x);
+        return {t, T{1} - t * t};
+    }
+};
+
+/// Kernel for the inverse hyperbolic sine
+struct Asinh {
+    /// @brief The inverse hyperbolic sine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::asinh(x), T{1} / std::sqrt(T{1} + x * x)};
+    }
+};
+
+/// Kernel for the inverse hyperbolic cosine
+struct Acosh {
+    /// @brief The inverse hyperbolic cosine of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::acosh(x), T{1} / std::sqrt(x * x - T{1})};
+    }
+};
+
+/// Kernel for the inverse hyperbolic tangent
+struct Atanh {
+    /// @brief The inverse hyperbolic tangent of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::atanh(x), T{1} / (T{1} - x * x)};
+    }
+};
+
+// -- Exponents ----------------------------------------------------------------
+
+/// Kernel for the square root
+struct Sqrt {
+    /// @brief The square root of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T s = std::sqrt(x);
+        return {s, T{1} / (T{2} * s)};
+    }
+};
+
+/// Kernel for the cube root
+struct Cbrt {
+    /// @brief The cube root of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T c = std::cbrt(x);
+        return {c, T{1} / (T{3} * c * c)};
+    }
+};
+
+/// Kernel for the exponential
+struct Exp {
+    /// @brief The exponential of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T e = std::exp(x);
+        return {e, e};
+    }
+};
+
+/// Kernel for the base 2 exponential
+struct Exp2 {
+    /// @brief Two raised to @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T e = std::exp2(x);
+        return {e, e * static_cast<T>(ln2)};
+    }
+};
+
+/// Kernel for the exponential minus one
+struct Expm1 {
+    /// @brief The exponential of @p x minus one and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T e = std::expm1(x);
+        return {e, e + T{1}};
+    }
+};
+
+/// Kernel for the natural logarithm
+struct Log {
+    /// @brief The natural logarithm of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::log(x), T{1} / x};
+    }
+};
+
+/// Kernel for the base 10 logarithm
+struct Log10 {
+    /// @brief The base 10 logarithm of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::log10(x), T{1} / (x * static_cast<T>(ln10))};
+    }
+};
+
+/// Kernel for the base 2 logarithm
+struct Log2 {
+    /// @brief The base 2 logarithm of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::log2(x), T{1} / (x * static_cast<T>(ln2))};
+    }
+};
+
+/// Kernel for the natural logarithm of one plus the argument
+struct Log1p {
+    /// @brief The natural logarithm of 1 + @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::log1p(x), T{1} / (x + T{1})};
+    }
+};
+
+// -- Error and Gamma ----------------------------------------------------------
+
+/// Kernel for the error function
+struct Erf {
+    /// @brief The error function of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::erf(x),
+                static_cast<T>(two_over_sqrt_pi) * std::exp(-x * x)};
+    }
+};
+
+/// Kernel for the complementary error function
+struct Erfc {
+    /// @brief The complementary error function of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::erfc(x),
+                -static_cast<T>(two_over_sqrt_pi) * std::exp(-x * x)};
+    }
+};
+
+/// Kernel for the gamma function
+struct Tgamma {
+    /// @brief The gamma function of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        T g = std::tgamma(x);
+        return {g, g * detail_::digamma(x)};
+    }
+};
+
+/// Kernel for the natural logarithm of the gamma function
+struct Lgamma {
+    /// @brief The log of the gamma function of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {std::lgamma(x), detail_::digamma(x)};
+    }
+};
+
+/// Kernel for the digamma function
+struct Digamma {
+    /// @brief The digamma function of @p x and its derivative
+    template<typename T>
+    ValueDeriv<T> operator()(T x) const {
+        return {detail_::digamma(x), detail_::trigamma(x)};
+    }
+};
+
+/// Kernel for the beta function
+struct Beta {
+    /// @brief The beta function of @p a and @p b and its partial derivatives
+    template<typename T>
+    ValueGrad<T> operator()(T a, T b) const {
+        // Going through lgamma avoids overflowing the gamma functions
+        T value = (a > T{0} && b > T{0}) ?
+                    std::exp(std::lgamma(a) + std::lgamma(b) -
+                             std::lgamma(a + b)) :
+                    std::tgamma(a) * std::tgamma(b) / std::tgamma(a + b);
+        T psi_ab = detail_::digamma(a + b);
+        return {value, value * (detail_::digamma(a) - psi_ab),
+                value * (detail_::digamma(b) - psi_ab)};
+    }
+};
+
+/// Kernel for the natural logarithm of the beta function
+struct Lbeta {
+    /// @brief The log of the beta function of @p a and @p b and its partial
+    ///        derivatives
+    template<typename T>
+    ValueGrad<T> operator()(T a, T b) const {
+        T psi_ab = detail_::digamma(a + b);
+        return {std::lgamma(a) + std::lgamma(b) - std::lgamma(a + b),
+                detail_::digamma(a) - psi_ab, detail_::digamma(b) - psi_ab};
+    }
+};
+
+// -- Batches ------------------------------------------------------------------
+
+/** @brief Evaluate a kernel over a batch of values
+ *
+ *  The values and derivatives are written to separate arrays, so the loop
+ *  can be vectorized (see SIGMA_SIMD).
+ *
+ *  @tparam Kernel The type of the kernel
+ *  @tparam T The numeric type
+ *  @param kernel The kernel
+ *  @param x The points to evaluate the kernel at
+ *  @param value Where the values of the function are written
+ *  @param deriv Where the derivatives of the function are written
+ *  @param n The number of points
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename Kernel, typename T>
+void evaluate(Kernel kernel, const T* x, T* value, T* deriv, std::size_t n) {
+    SIGMA_SIMD_LOOP
+    for(std::size_t i = 0; i < n; ++i) {
+        auto result = kernel(x[i]);
+        value[i]    = result.value;
+        deriv[i]    = result.deriv;
+    }
+}
+
+} // namespace sigma::kernels
+
+namespace sigma {
+
+/** @brief Apply a kernel to every variable in a batch
+ *
+ *  The means of the variables are gathered first, so that the kernel is
+ *  evaluated over all of them in a single loop (see kernels::evaluate()).
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
+ *  @tparam Kernel The type of the kernel
+ *  @param values The variables
+ *  @param kernel The kernel, e.g. kernels::Exp{}
+ *
+ *  @return The variables that result from applying the function of
+ *          @p kernel to each of @p values
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename T, typename D, typename Kernel>
+std::vector<Uncertain<T, D>> transform(
+  const std::vector<Uncertain<T, D>>& values, Kernel kernel) {
+    return transform(std::vector<Uncertain<T, D>>(values), kernel);
+}
+
+/** @overload
+ *
+ *  The variables are updated in place and returned.
+ */
+template<typename T, typename D, typename Kernel>
+std::vector<Uncertain<T, D>> transform(std::vector<Uncertain<T, D>>&& values,
+                                       Kernel kernel) {
+    auto n = values.size();
+    std::pmr::vector<T> buffer(3 * n, sigma::get_memory_resource());
+    T* x     = buffer.data();
+    T* value = x + n;
+    T* deriv = value + n;
+    for(std::size_t i = 0; i < n; ++i) x[i] = values[i].mean();
+    kernels::evaluate(kernel, x, value, deriv, n);
+    for(std::size_t i = 0; i < n; ++i) {
+        detail_::inplace_unary(values[i], value[i], deriv[i]);
+    }
+    return std::move(values);
+}
+
+} // namespace sigma
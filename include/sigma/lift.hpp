@@ -0,0 +1,182 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/dual.hpp"
+#include "sigma/uncertain.hpp"
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/** @file lift.hpp
+ *  @brief Propagation of uncertainty through generic functions
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/** @brief The argument of a lifted function corresponding to an operand
+ *
+ *  @tparam T The numeric type of the dual numbers
+ *  @tparam N The number of operands
+ *  @tparam Operand The type of the operand
+ *  @param x The operand
+ *  @param index The index of the operand
+ *
+ *  @return The variable with index @p index if @p x is an Uncertain, a
+ *          constant otherwise
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, std::size_t N, typename Operand>
+Dual<T, N> lift_argument(const Operand& x, std::size_t index) {
+    if constexpr(is_uncertain<Operand>::value) {
+        return Dual<T, N>::variable(x.mean(), index);
+    } else {
+        return Dual<T, N>(static_cast<T>(x));
+    }
+}
+
+/** @brief A variable depending on the uncertain ones among some operands
+ *
+ *  The dependencies of the operands are combined with a single merge.
+ *
+ *  @tparam T The numeric type
+ *  @tparam DerivativeType The type of @p deriv
+ *  @tparam Is The indices of the operands
+ *  @tparam Operands The types of the operands, plain numbers or Uncertain
+ *  @param mean The mean value of the result
+ *  @param deriv Returns the partial derivative of the result with respect
+ *               to the operand with the given index
+ *  @param operands The operands
+ *
+ *  @return A variable with the mean value @p mean and the dependencies of
+ *          the uncertain operands, each altered by its partial derivative
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename DerivativeType, std::size_t... Is,
+         typename... Operands>
+typename first_uncertain<Operands...>::type gradient_result(
+  T mean, DerivativeType deriv, std::index_sequence<Is...>,
+  const Operands&... operands) {
+    using uncertain_t = typename first_uncertain<Operands...>::type;
+    using value_t     = typename uncertain_t::value_t;
+    static_assert(((!is_uncertain<Operands>::value ||
+                    std::is_same_v<Operands, uncertain_t>)&&...),
+                  "The operands must be of the same Uncertain type");
+
+    constexpr std::size_t n_variables =
+      (std::size_t{is_uncertain<Operands>::value} + ...);
+    std::array<operand_t<uncertain_t>, n_variables> variables;
+    std::size_t n = 0;
+    auto add      = [&](const auto& x, value_t dcdx) {
+        if constexpr(is_uncertain<std::decay_t<decltype(x)>>::value) {
+            variables[n++] = {&x, dcdx};
+        }
+    };
+    (add(operands, deriv(Is)), ...);
+    return nary_result(static_cast<value_t>(mean), variables);
+}
+
+/** @brief A function that propagates uncertainty by forward-mode
+ *         differentiation
+ *
+ *  @tparam FunctionType The type of the wrapped function
+ */
+template<typename FunctionType>
+class Lifted {
+public:
+    /** @brief Wrap a function
+     *
+     *  @param f The function
+     *
+     *  @throw ... Any exception thrown by copying @p f
+     */
+    explicit Lifted(FunctionType f) : m_f_(std::move(f)) {}
+
+    /** @brief Evaluate the function
+     *
+     *  The function is called once, with each operand replaced by a dual
+     *  number, and the dependencies of the operands are then combined with
+     *  a single merge.
+     *
+     *  @tparam Operands The types of the operands. They are the same
+     *                   Uncertain type or plain numbers, and at least one is
+     *                   an Uncertain.
+     *  @param operands The operands
+     *
+     *  @return The value of the function at the means of @p operands, which
+     *          depends on the variables @p operands depend on
+     *
+     *  @throw std::bad_alloc if allocating the dependencies fails. Strong
+     *         throw guarantee.
+     *  @throw ... Any exception thrown by the function
+     */
+    template<typename... Operands>
+    typename first_uncertain<Operands...>::type operator()(
+      const Operands&... operands) const {
+        return call_(std::index_sequence_for<Operands...>{}, operands...);
+    }
+
+private:
+    /** @brief Implements operator()
+     *
+     *  @tparam Is The indices of the operands
+     *  @tparam Operands The types of the operands
+     *  @param operands The operands
+     *
+     *  @return The value of the function
+     */
+    template<std::size_t... Is, typename... Operands>
+    auto call_(std::index_sequence<Is...>, const Operands&... operands) const {
+        using uncertain_t   = typename first_uncertain<Operands...>::type;
+        using value_t       = typename uncertain_t::value_t;
+        constexpr auto size = sizeof...(Operands);
+
+        Dual<value_t, size> c =
+          m_f_(lift_argument<value_t, size>(operands, Is)...);
+        auto deriv = [&c](std::size_t i) { return c.derivative(i); };
+        return gradient_result(c.value(), deriv,
+                               std::index_sequence<Is...>{}, operands...);
+    }
+
+    /// The wrapped function
+    FunctionType m_f_;
+};
+
+} // namespace detail_
+
+/** @brief Lift a generic function to uncertain variables
+ *
+ *  The returned function object takes the same number of arguments as
+ *  @p f, any of which may be uncertain. It evaluates @p f once, on dual
+ *  numbers (see sigma::Dual), which gives the exact gradient of @p f with
+ *  respect to all of its arguments at the cost of about one evaluation,
+ *  instead of the two evaluations per argument of a numeric derivative.
+ *  @p f must be generic in its arguments, e.g. a generic lambda, use only
+ *  arithmetic, comparisons and the math functions sigma provides for Dual,
+ *  found by argument-dependent lookup, and return the result of that
+ *  computation.
+ *
+ *  @code
+ *  auto f = sigma::lift([](auto x, auto y) {
+ *      using std::exp;
+ *      return x * exp(-y);
+ *  });
+ *  sigma::UDouble z = f(a, b);
+ *  @endcode
+ *
+ *  @tparam FunctionType The type of the function
+ *  @param f The function
+ *
+ *  @return The lifted function
+ *
+ *  @throw ... Any exception thrown by copying @p f
+ */
+template<typename FunctionType>
+detail_::Lifted<FunctionType> lift(FunctionType f) {
+    return detail_::Lifted<FunctionType>(std::move(f));
+}
+
+} // namespace sigma
@@ -0,0 +1,277 @@
+#pragma once
+#include "sigma/detail_/deps_map.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/** @file memo.hpp
+ *  @brief Reuses the dependencies of repeated operations
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/** @brief Bounded cache of the dependencies formed by binary operations
+ *
+ *  The dependencies of the result of a binary operation are those of its
+ *  operands, each multiplied by the partial derivative with respect to it,
+ *  so they are determined by the operands' dependencies and the two partial
+ *  derivatives. The cache keeps copies of both, which for dependencies on
+ *  the heap share their blocks: a block held by the cache is never modified
+ *  in place, so an operand using the same block with the same scale factor
+ *  is known to have the same dependencies without comparing them.
+ *
+ *  Entries are direct-mapped, a new entry replacing whichever one was in
+ *  its slot. Only merges involving dependencies on the heap are cached;
+ *  merging inline dependencies costs less than looking them up.
+ *
+ *  @tparam DepsType The dependency storage type, a DepsMap
+ */
+template<typename DepsType>
+class MemoCache {
+public:
+    /// Type of the dependencies
+    using deps_map_t = DepsType;
+
+    /// Type of the partial derivatives
+    using deriv_t = typename deps_map_t::mapped_type;
+
+    /// Size type
+    using size_type = std::size_t;
+
+    /** @brief Construct an empty cache
+     *
+     *  @param capacity The maximum number of entries, rounded up to a power
+     *                  of two
+     *
+     *  @throw std::bad_alloc if allocating the entries fails. Strong throw
+     *         guarantee.
+     */
+    explicit MemoCache(size_type capacity) {
+        while(m_capacity_ < capacity) m_capacity_ *= 2;
+        m_entries_ = std::make_unique<Entry[]>(m_capacity_);
+    }
+
+    /** @brief Whether an operation is worth caching
+     *
+     *  @param a The dependencies of the first operand
+     *  @param b The dependencies of the second operand
+     *
+     *  @return Whether either operand's dependencies are on the heap
+     *
+     *  @throw none No throw guarantee
+     */
+    static bool cacheable(const deps_map_t& a, const deps_map_t& b) noexcept {
+        return !a.is_inline() || !b.is_inline();
+    }
+
+    /** @brief Look up the dependencies of a result
+     *
+     *  @param a The dependencies of the first operand
+     *  @param dcda The partial derivative with respect to the first operand
+     *  @param b The dependencies of the second operand
+     *  @param dcdb The partial derivative with respect to the second operand
+     *
+     *  @return The cached dependencies of the result, or null if there are
+     *          none. Valid until the next call to store().
+     *
+     *  @throw none No throw guarantee
+     */
+    const deps_map_t* find(const deps_map_t& a, deriv_t dcda,
+                           const deps_map_t& b, deriv_t dcdb) noexcept {
+        auto& entry = m_entries_[slot_(a, b)];
+        if(entry.used && entry.dcda == dcda && entry.dcdb == dcdb &&
+           same_(entry.a, a) && same_(entry.b, b)) {
+            ++m_hits_;
+            return &entry.result;
+        }
+        ++m_misses_;
+        return nullptr;
+    }
+
+    /** @brief Cache the dependencies of a result
+     *
+     *  @param a The dependencies of the first operand
+     *  @param dcda The partial derivative with respect to the first operand
+     *  @param b The dependencies of the second operand
+     *  @param dcdb The partial derivative with respect to the second operand
+     *  @param result The dependencies of the result
+     *
+     *  @throw none No throw guarantee
+     */
+    void store(const deps_map_t& a, deriv_t dcda, const deps_map_t& b,
+               deriv_t dcdb, const deps_map_t& result) noexcept {
+        auto& entry  = m_entries_[slot_(a, b)];
+        entry.a      = a;
+        entry.b      = b;
+        entry.dcda   = dcda;
+        entry.dcdb   = dcdb;
+        entry.result = result;
+        entry.used   = true;
+    }
+
+    /// @brief The number of lookups that found an entry
+    size_type hits() const noexcept { return m_hits_; }
+
+    /// @brief The number of lookups that did not
+    size_type misses() const noexcept { return m_misses_; }
+
+    /// @brief The maximum number of entries
+    size_type capacity() const noexcept { return m_capacity_; }
+
+private:
+    /// A cached operation
+    struct Entry {
+        /// The dependencies of the first operand
+        deps_map_t a;
+
+        /// The dependencies of the second operand
+        deps_map_t b;
+
+        /// The partial derivative with respect to the first operand
+        deriv_t dcda = 0;
+
+        /// The partial derivative with respect to the second operand
+        deriv_t dcdb = 0;
+
+        /// The dependencies of the result
+        deps_map_t result;
+
+        /// Whether the entry holds an operation
+        bool used = false;
+    };
+
+    /// Whether two maps are known to hold the same dependencies
+    static bool same_(const deps_map_t& lhs, const deps_map_t& rhs) noexcept {
+        if(lhs.size() != rhs.size()) return false;
+        if(lhs.is_inline()) return lhs == rhs;
+        return lhs.block() == rhs.block() &&
+               lhs.scale_factor() == rhs.scale_factor();
+    }
+
+    /// Hash of the identity of a map
+    static std::size_t hash_(const deps_map_t& deps) noexcept {
+        if(!deps.is_inline()) return std::hash<const void*>{}(deps.block());
+        std::size_t seed = deps.size();
+        for(const auto& [key, deriv] : deps) {
+            seed ^= std::hash<typename deps_map_t::key_type>{}(key) +
+                    0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+
+    /// The slot of an operation
+    size_type slot_(const deps_map_t& a, const deps_map_t& b) const noexcept {
+        auto h = hash_(a) * 31 + hash_(b);
+        return (h ^ (h >> 17)) & (m_capacity_ - 1);
+    }
+
+    /// The number of slots, a power of two
+    size_type m_capacity_ = 1;
+
+    /// The slots
+    std::unique_ptr<Entry[]> m_entries_;
+
+    /// The number of lookups that found an entry
+    size_type m_hits_ = 0;
+
+    /// The number of lookups that did not
+    size_type m_misses_ = 0;
+};
+
+/** @brief The cache selected for the calling thread
+ *
+ *  @tparam DepsType The dependency storage type
+ *
+ *  @return The cache, null if operations are not memoized
+ */
+template<typename DepsType>
+MemoCache<DepsType>*& thread_memo_cache() noexcept {
+    thread_local MemoCache<DepsType>* cache = nullptr;
+    return cache;
+}
+
+} // namespace detail_
+
+/** @brief Memoizes repeated operations on the calling thread for its
+ *         lifetime
+ *
+ *  While the scope is alive, binary operations on variables of type
+ *  @p UncertainType whose operands are both lvalues, e.g. `a * b` or
+ *  `pow(a, b)`, look up the dependencies of their result in a bounded
+ *  cache before merging those of the operands. Repeating an operation on
+ *  the same operands then costs a lookup and a copy that shares the cached
+ *  storage. Unary operations are not cached, since they already only share
+ *  and rescale the storage of their operand.
+ *
+ *  @code
+ *  {
+ *      sigma::ScopedMemo<sigma::UDouble> memo;
+ *      auto y = a * b + c;
+ *      auto z = a * b - c; // reuses the dependencies of a * b
+ *  }
+ *  @endcode
+ *
+ *  Scopes may be nested, the innermost one being used. The cache holds on
+ *  to the dependencies it has seen, so a memory resource they were
+ *  allocated from (see ScopedMemoryResource) must outlive the scope. Only
+ *  available for the default dependency storage.
+ *
+ *  @tparam UncertainType The type of the variables to memoize operations on
+ */
+template<typename UncertainType>
+class ScopedMemo {
+public:
+    /// Type of the dependencies
+    using deps_map_t = typename UncertainType::deps_map_t;
+
+    /// Type of the cache
+    using cache_t = detail_::MemoCache<deps_map_t>;
+
+    /// Size type
+    using size_type = typename cache_t::size_type;
+
+    static_assert(detail_::is_deps_map_v<deps_map_t>,
+                  "Only the default dependency storage can be memoized");
+
+    /** @brief Start memoizing operations on the calling thread
+     *
+     *  @param capacity The maximum number of operations remembered
+     *
+     *  @throw std::bad_alloc if allocating the cache fails. Strong throw
+     *         guarantee.
+     */
+    explicit ScopedMemo(size_type capacity = 4096) :
+      m_cache_(capacity), m_previous_(detail_::thread_memo_cache<deps_map_t>()) {
+        detail_::thread_memo_cache<deps_map_t>() = &m_cache_;
+    }
+
+    /// @brief Deleted copy ctor, the scope is tied to the calling thread
+    ScopedMemo(const ScopedMemo&) = delete;
+
+    /// @brief Deleted copy assignment, the scope is tied to the calling thread
+    ScopedMemo& operator=(const ScopedMemo&) = delete;
+
+    /// @brief Stop memoizing, restoring the cache used before this scope
+    ~ScopedMemo() noexcept {
+        detail_::thread_memo_cache<deps_map_t>() = m_previous_;
+    }
+
+    /** @brief The cache of this scope
+     *
+     *  @return The cache, e.g. to inspect its hits() and misses()
+     *
+     *  @throw none No throw guarantee
+     */
+    const cache_t& cache() const noexcept { return m_cache_; }
+
+private:
+    /// The cache of this scope
+    cache_t m_cache_;
+
+    /// The cache used before this scope
+    cache_t* m_previous_;
+};
+
+} // namespace sigma
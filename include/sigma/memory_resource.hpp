@@ -0,0 +1,101 @@
+#pragma once
+#include <memory_resource>
+
+/** @file memory_resource.hpp
+ *  @brief Controls where the dependencies of uncertain variables are stored
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/// The resource selected for the calling thread, null for the default one
+inline std::pmr::memory_resource*& thread_memory_resource() noexcept {
+    thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+} // namespace detail_
+
+/** @brief Get the memory resource used by the calling thread
+ *
+ *  Dependencies that do not fit inside an Uncertain instance are stored in
+ *  memory obtained from this resource. Unless set_memory_resource() was
+ *  called by this thread it is `std::pmr::get_default_resource()`.
+ *
+ *  @return The memory resource new dependency storage is allocated from
+ *
+ *  @throw none No throw guarantee
+ */
+inline std::pmr::memory_resource* get_memory_resource() noexcept {
+    auto* resource = detail_::thread_memory_resource();
+    return resource ? resource : std::pmr::get_default_resource();
+}
+
+/** @brief Set the memory resource used by the calling thread
+ *
+ *  Only storage allocated afterwards, by this thread, comes from
+ *  @p resource; storage is always returned to the resource it came from.
+ *  The resource must therefore outlive every variable whose dependencies
+ *  were allocated from it, and must tolerate being released from other
+ *  threads if such variables are shared with them.
+ *
+ *  @param resource The resource to allocate from. If null, the default
+ *                  resource is used again.
+ *
+ *  @return The resource previously set by this thread, null if it was
+ *          using the default resource. Passing it back restores the
+ *          previous state, including following later changes to the
+ *          default resource.
+ *
+ *  @throw none No throw guarantee
+ */
+inline std::pmr::memory_resource* set_memory_resource(
+  std::pmr::memory_resource* resource) noexcept {
+    auto*& current = detail_::thread_memory_resource();
+    auto* previous = current;
+    current        = resource;
+    return previous;
+}
+
+/** @brief Uses a memory resource on the calling thread for its lifetime
+ *
+ *  Typical use is an arena per computation, released in one go once its
+ *  results are no longer needed:
+ *
+ *  @code
+ *  std::pmr::monotonic_buffer_resource arena;
+ *  {
+ *      sigma::ScopedMemoryResource scope(&arena);
+ *      // ... temporaries and results allocate from arena ...
+ *  }
+ *  @endcode
+ *
+ *  See set_memory_resource() for the lifetime requirements.
+ */
+class ScopedMemoryResource {
+public:
+    /** @brief Start using @p resource on the calling thread
+     *
+     *  @param resource The resource to allocate from
+     *
+     *  @throw none No throw guarantee
+     */
+    explicit ScopedMemoryResource(
+      std::pmr::memory_resource* resource) noexcept :
+      m_previous_(set_memory_resource(resource)) {}
+
+    /// @brief Deleted copy ctor, the scope is tied to the calling thread
+    ScopedMemoryResource(const ScopedMemoryResource&) = delete;
+
+    /// @brief Deleted copy assignment, the scope is tied to the calling thread
+    ScopedMemoryResource& operator=(const ScopedMemoryResource&) = delete;
+
+    /// @brief Restore the resource used before this scope
+    ~ScopedMemoryResource() noexcept { set_memory_resource(m_previous_); }
+
+private:
+    /// The resource set before this scope, null for the default one
+    std::pmr::memory_resource* m_previous_;
+};
+
+} // namespace sigma
@@ -10,18 +10,23 @@ namespace sigma {
 /** @brief Negation Operation
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable being negated
  *
  *  @return A copy of @p a, but with the sign of the mean reversed
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& a);
 
 /** @brief Addition Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -29,18 +34,35 @@ Uncertain<T> operator-(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator+(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator+(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator+(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator+(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator+(const Uncertain<T, D>& lhs, double rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator+(Uncertain<T, D>&& lhs, double rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator+(double lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator+(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator+(double lhs, Uncertain<T, D>&& rhs);
 
 /** @brief Inplace Addition Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -48,15 +70,16 @@ Uncertain<T> operator+(double lhs, const Uncertain<T>& rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator+=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator+=(Uncertain<T, D>& lhs, double rhs);
 
 /** @brief Subtraction Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -64,18 +87,35 @@ Uncertain<T>& operator+=(Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& lhs, double rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& lhs, double rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator-(double lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator-(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator-(double lhs, Uncertain<T, D>&& rhs);
 
 /** @brief Inplace Subtraction Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -83,15 +123,16 @@ Uncertain<T> operator-(double lhs, const Uncertain<T>& rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator-=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator-=(Uncertain<T, D>& lhs, double rhs);
 
 /** @brief Multiplication Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -99,18 +140,35 @@ Uncertain<T>& operator-=(Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator*(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator*(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator*(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator*(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator*(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator*(const Uncertain<T, D>& lhs, double rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator*(Uncertain<T, D>&& lhs, double rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator*(double lhs, const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator*(double lhs, Uncertain<T, D>&& rhs);
 
 /** @brief Inplace Multiplication Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -118,15 +176,16 @@ Uncertain<T> operator*(double lhs, const Uncertain<T>& rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator*=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator*=(Uncertain<T, D>& lhs, double rhs);
 
 /** @brief Division Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable
  *  @param rhs The right-hand variable
  *
@@ -134,18 +193,35 @@ Uncertain<T>& operator*=(Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator/(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator/(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator/(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator/(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator/(double lhs, const Uncertain<T, D>& rhs);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> operator/(double lhs, Uncertain<T, D>&& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator/(double lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator/(const Uncertain<T, D>& lhs, double rhs);
 /** @overload */
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator/(Uncertain<T, D>&& lhs, double rhs);
 
 /** @brief Inplace Division Operation
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param lhs The left-hand variable being modified
  *  @param rhs The right-hand variable
  *
@@ -153,11 +229,11 @@ Uncertain<T> operator/(const Uncertain<T>& lhs, double rhs);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, const Uncertain<T>& rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator/=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs);
 /** @overload */
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, double rhs);
+template<typename T, typename D>
+Uncertain<T, D>& operator/=(Uncertain<T, D>& lhs, double rhs);
 
 } // namespace sigma
 
@@ -4,36 +4,80 @@
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& a) {
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& a) {
     T mean = -a.mean();
     T dcda = -1.0;
     return detail_::unary_result(a, mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
-    c += rhs;
-    return c;
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& a) {
+    T mean = -a.mean();
+    T dcda = -1.0;
+    return detail_::unary_result(std::move(a), mean, dcda);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator+(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs) {
+    T mean = lhs.mean() + rhs.mean();
+    T dcda = 1.0;
+    T dcdb = 1.0;
+    return detail_::binary_result(lhs, rhs, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator+(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs) {
+    lhs += rhs;
+    return std::move(lhs);
 }
 
-template<typename T>
-Uncertain<T> operator+(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename D>
+Uncertain<T, D> operator+(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() + rhs.mean();
+    T dcda = 1.0;
+    T dcdb = 1.0;
+    return detail_::binary_result(lhs, std::move(rhs), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator+(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() + rhs.mean();
+    T dcda = 1.0;
+    T dcdb = 1.0;
+    return detail_::binary_result(std::move(lhs), std::move(rhs), mean, dcda,
+                                  dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator+(const Uncertain<T, D>& lhs, double rhs) {
+    Uncertain<T, D> c(lhs);
     c += rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator+(double lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(rhs);
+template<typename T, typename D>
+Uncertain<T, D> operator+(Uncertain<T, D>&& lhs, double rhs) {
+    lhs += rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator+(double lhs, const Uncertain<T, D>& rhs) {
+    Uncertain<T, D> c(rhs);
     c += lhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D> operator+(double lhs, Uncertain<T, D>&& rhs) {
+    rhs += lhs;
+    return std::move(rhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D>& operator+=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs) {
     T mean = lhs.mean() + rhs.mean();
     T dcda = 1.0;
     T dcdb = 1.0;
@@ -41,37 +85,73 @@ Uncertain<T>& operator+=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator+=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename D>
+Uncertain<T, D>& operator+=(Uncertain<T, D>& lhs, double rhs) {
     T mean = lhs.mean() + rhs;
     T dcda = 1.0;
     detail_::inplace_unary(lhs, mean, dcda);
     return lhs;
 }
 
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
-    c -= rhs;
-    return c;
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs) {
+    T mean = lhs.mean() - rhs.mean();
+    T dcda = 1.0;
+    T dcdb = -1.0;
+    return detail_::binary_result(lhs, rhs, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs) {
+    lhs -= rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() - rhs.mean();
+    T dcda = 1.0;
+    T dcdb = -1.0;
+    return detail_::binary_result(lhs, std::move(rhs), mean, dcda, dcdb);
 }
 
-template<typename T>
-Uncertain<T> operator-(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() - rhs.mean();
+    T dcda = 1.0;
+    T dcdb = -1.0;
+    return detail_::binary_result(std::move(lhs), std::move(rhs), mean, dcda,
+                                  dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator-(const Uncertain<T, D>& lhs, double rhs) {
+    Uncertain<T, D> c(lhs);
     c -= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator-(double lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D> operator-(Uncertain<T, D>&& lhs, double rhs) {
+    lhs -= rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator-(double lhs, const Uncertain<T, D>& rhs) {
+    return lhs - Uncertain<T, D>(rhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator-(double lhs, Uncertain<T, D>&& rhs) {
     T mean = lhs - rhs.mean();
     T dcda = -1.0;
-    return detail_::unary_result(rhs, mean, dcda);
+    return detail_::unary_result(std::move(rhs), mean, dcda);
 }
 
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D>& operator-=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs) {
     T mean = lhs.mean() - rhs.mean();
     T dcda = 1.0;
     T dcdb = -1.0;
@@ -79,35 +159,71 @@ Uncertain<T>& operator-=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator-=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename D>
+Uncertain<T, D>& operator-=(Uncertain<T, D>& lhs, double rhs) {
     T mean = lhs.mean() - rhs;
     T dcda = 1.0;
     detail_::inplace_unary(lhs, mean, dcda);
     return lhs;
 }
 
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
-    c *= rhs;
-    return c;
+template<typename T, typename D>
+Uncertain<T, D> operator*(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs) {
+    T mean = lhs.mean() * rhs.mean();
+    T dcda = rhs.mean();
+    T dcdb = lhs.mean();
+    return detail_::binary_result(lhs, rhs, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator*(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs) {
+    lhs *= rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator*(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() * rhs.mean();
+    T dcda = rhs.mean();
+    T dcdb = lhs.mean();
+    return detail_::binary_result(lhs, std::move(rhs), mean, dcda, dcdb);
 }
 
-template<typename T>
-Uncertain<T> operator*(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename D>
+Uncertain<T, D> operator*(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() * rhs.mean();
+    T dcda = rhs.mean();
+    T dcdb = lhs.mean();
+    return detail_::binary_result(std::move(lhs), std::move(rhs), mean, dcda,
+                                  dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator*(const Uncertain<T, D>& lhs, double rhs) {
+    Uncertain<T, D> c(lhs);
     c *= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator*(double lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D> operator*(Uncertain<T, D>&& lhs, double rhs) {
+    lhs *= rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator*(double lhs, const Uncertain<T, D>& rhs) {
     return rhs * lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D> operator*(double lhs, Uncertain<T, D>&& rhs) {
+    return std::move(rhs) * lhs;
+}
+
+template<typename T, typename D>
+Uncertain<T, D>& operator*=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs) {
     T mean = lhs.mean() * rhs.mean();
     T dcda = rhs.mean();
     T dcdb = lhs.mean();
@@ -115,37 +231,73 @@ Uncertain<T>& operator*=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator*=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename D>
+Uncertain<T, D>& operator*=(Uncertain<T, D>& lhs, double rhs) {
     T mean = lhs.mean() * rhs;
     T dcda = rhs;
     detail_::inplace_unary(lhs, mean, dcda);
     return lhs;
 }
 
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, const Uncertain<T>& rhs) {
-    Uncertain<T> c(lhs);
-    c /= rhs;
-    return c;
+template<typename T, typename D>
+Uncertain<T, D> operator/(const Uncertain<T, D>& lhs,
+                          const Uncertain<T, D>& rhs) {
+    T mean = lhs.mean() / rhs.mean();
+    T dcda = 1.0 / rhs.mean();
+    T dcdb = -lhs.mean() / std::pow(rhs.mean(), 2.0);
+    return detail_::binary_result(lhs, rhs, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator/(Uncertain<T, D>&& lhs, const Uncertain<T, D>& rhs) {
+    lhs /= rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator/(const Uncertain<T, D>& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() / rhs.mean();
+    T dcda = 1.0 / rhs.mean();
+    T dcdb = -lhs.mean() / std::pow(rhs.mean(), 2.0);
+    return detail_::binary_result(lhs, std::move(rhs), mean, dcda, dcdb);
 }
 
-template<typename T>
-Uncertain<T> operator/(const Uncertain<T>& lhs, double rhs) {
-    Uncertain<T> c(lhs);
+template<typename T, typename D>
+Uncertain<T, D> operator/(Uncertain<T, D>&& lhs, Uncertain<T, D>&& rhs) {
+    T mean = lhs.mean() / rhs.mean();
+    T dcda = 1.0 / rhs.mean();
+    T dcdb = -lhs.mean() / std::pow(rhs.mean(), 2.0);
+    return detail_::binary_result(std::move(lhs), std::move(rhs), mean, dcda,
+                                  dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator/(const Uncertain<T, D>& lhs, double rhs) {
+    Uncertain<T, D> c(lhs);
     c /= rhs;
     return c;
 }
 
-template<typename T>
-Uncertain<T> operator/(double lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D> operator/(Uncertain<T, D>&& lhs, double rhs) {
+    lhs /= rhs;
+    return std::move(lhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator/(double lhs, const Uncertain<T, D>& rhs) {
+    return lhs / Uncertain<T, D>(rhs);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> operator/(double lhs, Uncertain<T, D>&& rhs) {
     T mean = lhs / rhs.mean();
     T dcda = -lhs / std::pow(rhs.mean(), 2.0);
-    return detail_::unary_result(rhs, mean, dcda);
+    return detail_::unary_result(std::move(rhs), mean, dcda);
 }
 
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
+template<typename T, typename D>
+Uncertain<T, D>& operator/=(Uncertain<T, D>& lhs, const Uncertain<T, D>& rhs) {
     T mean = lhs.mean() / rhs.mean();
     T dcda = 1.0 / rhs.mean();
     T dcdb = -lhs.mean() / std::pow(rhs.mean(), 2.0);
@@ -153,8 +305,8 @@ Uncertain<T>& operator/=(Uncertain<T>& lhs, const Uncertain<T>& rhs) {
     return lhs;
 }
 
-template<typename T>
-Uncertain<T>& operator/=(Uncertain<T>& lhs, double rhs) {
+template<typename T, typename D>
+Uncertain<T, D>& operator/=(Uncertain<T, D>& lhs, double rhs) {
     T mean = lhs.mean() / rhs;
     T dcda = 1.0 / rhs;
     detail_::inplace_unary(lhs, mean, dcda);
@@ -10,70 +10,85 @@ namespace sigma {
 /** @brief Absolute Value
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The absolute value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> abs(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> abs(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> abs(Uncertain<T, D>&& a);
 
 /** @brief Absolute Value
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The absolute value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> fabs(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> fabs(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fabs(Uncertain<T, D>&& a);
 
 /** @brief The Square of the Absolute Value
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The square of the absolute value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> abs2(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> abs2(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> abs2(Uncertain<T, D>&& a);
 
 /** @brief Nearest integer not less than the given value
  *
- *  Note that this returns an Uncertain<T> value with no dependencies
+ *  Note that this returns an Uncertain<T, D> value with no dependencies
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The nearest integer not greater than @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> ceil(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> ceil(const Uncertain<T, D>& a);
 
 /** @brief Nearest integer not greater than the given value
  *
- *  Note that this returns an Uncertain<T> value with no dependencies
+ *  Note that this returns an Uncertain<T, D> value with no dependencies
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The nearest integer not greater than @p u
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> floor(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> floor(const Uncertain<T, D>& a);
 
 /** @brief Floating point module
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The first variable
  *  @param b The first variable
  *
@@ -81,18 +96,75 @@ Uncertain<T> floor(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, const Uncertain<T>& b);
+template<typename T, typename D>
+Uncertain<T, D> fmod(const Uncertain<T, D>& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fmod(Uncertain<T, D>&& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fmod(const Uncertain<T, D>& a, Uncertain<T, D>&& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fmod(Uncertain<T, D>&& a, Uncertain<T, D>&& b);
 /** @overload */
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, double b);
+template<typename T, typename D>
+Uncertain<T, D> fmod(const Uncertain<T, D>& a, double b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fmod(Uncertain<T, D>&& a, double b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fmod(double a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> fmod(double a, Uncertain<T, D>&& b);
+
+/** @brief Fused multiply-add
+ *
+ *  The mean is computed with a single rounding, and the dependencies of
+ *  the three variables are combined in a single merge.
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
+ *  @param a The first factor
+ *  @param b The second factor
+ *  @param c The variable added to the product
+ *
+ *  @return A variable that is `a * b + c`
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename D>
+Uncertain<T, D> fma(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                    const Uncertain<T, D>& c);
+
+/** @brief Linear interpolation between two variables
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
+ *  @param a The value at @p t = 0
+ *  @param b The value at @p t = 1
+ *  @param t The interpolation parameter
+ *
+ *  @return A variable that is `a + t * (b - a)`
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename D>
+Uncertain<T, D> lerp(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                     const Uncertain<T, D>& t);
 /** @overload */
-template<typename T>
-Uncertain<T> fmod(double a, const Uncertain<T>& b);
+template<typename T, typename D>
+Uncertain<T, D> lerp(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                     double t);
 
 /** @brief Copy the sign of one value to another
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose magnitude is copied
  *  @param b The variable whose sign is copied
  *
@@ -100,12 +172,16 @@ Uncertain<T> fmod(double a, const Uncertain<T>& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> copysign(const Uncertain<T>& a, const Uncertain<T>& b);
+template<typename T, typename D>
+Uncertain<T, D> copysign(const Uncertain<T, D>& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> copysign(Uncertain<T, D>&& a, const Uncertain<T, D>& b);
 
 /** @brief Copy the sign of one value to another
  *
  *  @tparam T The value type of @p a
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of @p b
  *  @param a The variable whose magnitude is copied
  *  @param b The variable whose sign is copied
@@ -114,12 +190,16 @@ Uncertain<T> copysign(const Uncertain<T>& a, const Uncertain<T>& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> copysign(const Uncertain<T>& a, const U& b);
+template<typename T, typename D, typename U>
+Uncertain<T, D> copysign(const Uncertain<T, D>& a, const U& b);
+/** @overload */
+template<typename T, typename D, typename U>
+Uncertain<T, D> copysign(Uncertain<T, D>&& a, const U& b);
 
 /** @brief Copy the sign of one value to another
  *
  *  @tparam T The value type of @p b
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of @p a
  *  @param a The variable whose magnitude is copied
  *  @param b The variable whose sign is copied
@@ -128,32 +208,34 @@ Uncertain<T> copysign(const Uncertain<T>& a, const U& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-U copysign(const U& a, const Uncertain<T>& b);
+template<typename T, typename D, typename U>
+U copysign(const U& a, const Uncertain<T, D>& b);
 
 /** @brief Remove the fractional part from a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose value is truncated
  *
  *  @return A variable whose value is the truncated value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> trunc(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> trunc(const Uncertain<T, D>& a);
 
 /** @brief Round to the nearest integar, away from zero in halfway case.
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose value is truncated
  *
  *  @return A variable whose value is the rounded value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> round(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> round(const Uncertain<T, D>& a);
 
 } // namespace sigma
 
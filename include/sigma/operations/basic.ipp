@@ -1,85 +1,178 @@
 #pragma once
 
 #include "sigma/detail_/operation_common.hpp"
+#include <array>
 #include <cmath>
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> abs(const Uncertain<T>& a) {
+template<typename T, typename D>
+Uncertain<T, D> abs(const Uncertain<T, D>& a) {
+    return abs(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> abs(Uncertain<T, D>&& a) {
     T mean = std::abs(a.mean());
     T dcda = (a.mean() >= 0) ? 1.0 : -1.0;
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> fabs(const Uncertain<T>& a) {
+template<typename T, typename D>
+Uncertain<T, D> fabs(const Uncertain<T, D>& a) {
     return abs(a);
 }
 
-template<typename T>
-Uncertain<T> abs2(const Uncertain<T>& a) {
+template<typename T, typename D>
+Uncertain<T, D> fabs(Uncertain<T, D>&& a) {
+    return abs(std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> abs2(const Uncertain<T, D>& a) {
     return pow(abs(a), 2.0);
 }
 
-template<typename T>
-Uncertain<T> ceil(const Uncertain<T>& a) {
-    return Uncertain<T>(std::ceil(a.mean()));
+template<typename T, typename D>
+Uncertain<T, D> abs2(Uncertain<T, D>&& a) {
+    return pow(abs(std::move(a)), 2.0);
 }
 
-template<typename T>
-Uncertain<T> floor(const Uncertain<T>& a) {
-    return Uncertain<T>(std::floor(a.mean()));
+template<typename T, typename D>
+Uncertain<T, D> ceil(const Uncertain<T, D>& a) {
+    return Uncertain<T, D>(std::ceil(a.mean()));
 }
 
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, const Uncertain<T>& b) {
+template<typename T, typename D>
+Uncertain<T, D> floor(const Uncertain<T, D>& a) {
+    return Uncertain<T, D>(std::floor(a.mean()));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fmod(const Uncertain<T, D>& a, const Uncertain<T, D>& b) {
     T mean = std::fmod(a.mean(), b.mean());
     T dcda = 1.0;
     T dcdb = -std::floor(a.mean() / b.mean());
     return detail_::binary_result(a, b, mean, dcda, dcdb);
 }
 
-template<typename T>
-Uncertain<T> fmod(const Uncertain<T>& a, double b) {
+template<typename T, typename D>
+Uncertain<T, D> fmod(Uncertain<T, D>&& a, const Uncertain<T, D>& b) {
+    T mean = std::fmod(a.mean(), b.mean());
+    T dcda = 1.0;
+    T dcdb = -std::floor(a.mean() / b.mean());
+    return detail_::binary_result(std::move(a), b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fmod(const Uncertain<T, D>& a, Uncertain<T, D>&& b) {
+    T mean = std::fmod(a.mean(), b.mean());
+    T dcda = 1.0;
+    T dcdb = -std::floor(a.mean() / b.mean());
+    return detail_::binary_result(a, std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fmod(Uncertain<T, D>&& a, Uncertain<T, D>&& b) {
+    T mean = std::fmod(a.mean(), b.mean());
+    T dcda = 1.0;
+    T dcdb = -std::floor(a.mean() / b.mean());
+    return detail_::binary_result(std::move(a), std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fmod(const Uncertain<T, D>& a, double b) {
+    return fmod(Uncertain<T, D>(a), b);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fmod(Uncertain<T, D>&& a, double b) {
     T mean = std::fmod(a.mean(), b);
     T dcda = 1.0;
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> fmod(double a, const Uncertain<T>& b) {
+template<typename T, typename D>
+Uncertain<T, D> fmod(double a, const Uncertain<T, D>& b) {
+    return fmod(a, Uncertain<T, D>(b));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fmod(double a, Uncertain<T, D>&& b) {
     T mean = std::fmod(a, b.mean());
     T dcda = -std::floor(a / b.mean());
-    return detail_::unary_result(b, mean, dcda);
+    return detail_::unary_result(std::move(b), mean, dcda);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> fma(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                    const Uncertain<T, D>& c) {
+    T mean = std::fma(a.mean(), b.mean(), c.mean());
+    T dcda = b.mean();
+    T dcdb = a.mean();
+    T dcdc = 1.0;
+    std::array<detail_::operand_t<Uncertain<T, D>>, 3> operands{
+      {{&a, dcda}, {&b, dcdb}, {&c, dcdc}}};
+    return detail_::nary_result(mean, operands);
 }
 
-template<typename T>
-Uncertain<T> copysign(const Uncertain<T>& a, const Uncertain<T>& b) {
+template<typename T, typename D>
+Uncertain<T, D> lerp(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                     const Uncertain<T, D>& t) {
+    T mean = a.mean() + t.mean() * (b.mean() - a.mean());
+    T dcda = 1.0 - t.mean();
+    T dcdb = t.mean();
+    T dcdt = b.mean() - a.mean();
+    std::array<detail_::operand_t<Uncertain<T, D>>, 3> operands{
+      {{&a, dcda}, {&b, dcdb}, {&t, dcdt}}};
+    return detail_::nary_result(mean, operands);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lerp(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                     double t) {
+    T mean = a.mean() + t * (b.mean() - a.mean());
+    T dcda = 1.0 - t;
+    T dcdb = t;
+    return detail_::binary_result(a, b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> copysign(const Uncertain<T, D>& a, const Uncertain<T, D>& b) {
     return copysign(a, b.mean());
 }
 
-template<typename T, typename U>
-Uncertain<T> copysign(const Uncertain<T>& a, const U& b) {
+template<typename T, typename D>
+Uncertain<T, D> copysign(Uncertain<T, D>&& a, const Uncertain<T, D>& b) {
+    return copysign(std::move(a), b.mean());
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> copysign(const Uncertain<T, D>& a, const U& b) {
+    return copysign(Uncertain<T, D>(a), b);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> copysign(Uncertain<T, D>&& a, const U& b) {
     auto b_sign = std::copysign(1.0, b);
     T mean      = std::copysign(a.mean(), b);
     T dcda      = (a.mean() >= 0) ? b_sign : -b_sign;
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
 }
 
-template<typename T, typename U>
-U copysign(const U& a, const Uncertain<T>& b) {
+template<typename T, typename D, typename U>
+U copysign(const U& a, const Uncertain<T, D>& b) {
     return std::copysign(a, b.mean());
 }
 
-template<typename T>
-Uncertain<T> trunc(const Uncertain<T>& a) {
-    return Uncertain<T>(std::trunc(a.mean()));
+template<typename T, typename D>
+Uncertain<T, D> trunc(const Uncertain<T, D>& a) {
+    return Uncertain<T, D>(std::trunc(a.mean()));
 }
 
-template<typename T>
-Uncertain<T> round(const Uncertain<T>& a) {
-    return Uncertain<T>(std::round(a.mean()));
+template<typename T, typename D>
+Uncertain<T, D> round(const Uncertain<T, D>& a) {
+    return Uncertain<T, D>(std::round(a.mean()));
 }
 
 } // namespace sigma
@@ -13,14 +13,15 @@ namespace sigma {
  *  This is a stub to satisfy Eigen
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The complex conjugate of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-const Uncertain<T>& conj(const Uncertain<T>& a) {
+template<typename T, typename D>
+const Uncertain<T, D>& conj(const Uncertain<T, D>& a) {
     return a;
 }
 
@@ -29,14 +30,15 @@ const Uncertain<T>& conj(const Uncertain<T>& a) {
  *  This is a stub to satisfy Eigen
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The real part of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-const Uncertain<T>& real(const Uncertain<T>& a) {
+template<typename T, typename D>
+const Uncertain<T, D>& real(const Uncertain<T, D>& a) {
     return a;
 }
 
@@ -45,15 +47,16 @@ const Uncertain<T>& real(const Uncertain<T>& a) {
  *  This is a stub to satisfy Eigen
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The imaginary part of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> imag(const Uncertain<T>& a) {
-    return Uncertain<T>{0.0, 0.0};
+template<typename T, typename D>
+Uncertain<T, D> imag(const Uncertain<T, D>& a) {
+    return Uncertain<T, D>{0.0, 0.0};
 }
 
 } // namespace sigma
@@ -10,50 +10,154 @@ namespace sigma {
 /** @brief Error function
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The error function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> erf(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> erf(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> erf(Uncertain<T, D>&& a);
 
 /** @brief Complementary error function
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The complementary error function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> erfc(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> erfc(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> erfc(Uncertain<T, D>&& a);
 
 /** @brief Gamma function
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The gamma function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> tgamma(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> tgamma(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> tgamma(Uncertain<T, D>&& a);
 
 /** @brief Gamma function Natural Logarithm
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The natural logarithm of the gamma function value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> lgamma(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> lgamma(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lgamma(Uncertain<T, D>&& a);
+
+/** @brief Digamma function, the derivative of the natural logarithm of the
+ *         gamma function
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
+ *  @param a The variable
+ *
+ *  @return The digamma function value of @p a
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename D>
+Uncertain<T, D> digamma(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> digamma(Uncertain<T, D>&& a);
+
+/** @brief Beta function
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
+ *  @param a The first variable
+ *  @param b The second variable
+ *
+ *  @return A variable that is the beta function of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename D>
+Uncertain<T, D> beta(const Uncertain<T, D>& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(Uncertain<T, D>&& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(const Uncertain<T, D>& a, Uncertain<T, D>&& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(Uncertain<T, D>&& a, Uncertain<T, D>&& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(const Uncertain<T, D>& a, double b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(Uncertain<T, D>&& a, double b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(double a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> beta(double a, Uncertain<T, D>&& b);
+
+/** @brief Beta function Natural Logarithm
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
+ *  @param a The first variable
+ *  @param b The second variable
+ *
+ *  @return A variable that is the natural logarithm of the absolute value
+ *          of the beta function of @p a and @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(const Uncertain<T, D>& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(Uncertain<T, D>&& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(const Uncertain<T, D>& a, Uncertain<T, D>&& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(Uncertain<T, D>&& a, Uncertain<T, D>&& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(const Uncertain<T, D>& a, double b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(Uncertain<T, D>&& a, double b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(double a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> lbeta(double a, Uncertain<T, D>&& b);
 
 } // namespace sigma
 
@@ -1,39 +1,152 @@
 #pragma once
 
 #include "sigma/detail_/operation_common.hpp"
+#include "sigma/kernels.hpp"
 #include <cmath>
 
 namespace sigma {
 
 // -- Definitions --------------------------------------------------------------
-template<typename T>
-Uncertain<T> erf(const Uncertain<T>& a) {
-    T mean = std::erf(a.mean());
-    T dcda = std::exp(-std::pow(a.mean(), 2)) * (2 / std::sqrt(detail_::pi));
-    return detail_::unary_result(a, mean, dcda);
-}
-
-template<typename T>
-Uncertain<T> erfc(const Uncertain<T>& a) {
-    T mean = std::erfc(a.mean());
-    T dcda = -std::exp(-std::pow(a.mean(), 2)) * (2 / std::sqrt(detail_::pi));
-    return detail_::unary_result(a, mean, dcda);
-}
-
-template<typename T>
-Uncertain<T> tgamma(const Uncertain<T>& a) {
-    auto func = [](decltype(a.mean()) x) { return std::tgamma(x); };
-    T mean    = std::tgamma(a.mean());
-    T dcda    = detail_::numeric_derivative(func, a.mean());
-    return detail_::unary_result(a, mean, dcda);
-}
-
-template<typename T>
-Uncertain<T> lgamma(const Uncertain<T>& a) {
-    auto func = [](decltype(a.mean()) x) { return std::lgamma(x); };
-    T mean    = std::lgamma(a.mean());
-    T dcda    = detail_::numeric_derivative(func, a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> erf(const Uncertain<T, D>& a) {
+    return erf(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> erf(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Erf{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> erfc(const Uncertain<T, D>& a) {
+    return erfc(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> erfc(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Erfc{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> tgamma(const Uncertain<T, D>& a) {
+    return tgamma(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> tgamma(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Tgamma{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lgamma(const Uncertain<T, D>& a) {
+    return lgamma(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lgamma(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Lgamma{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> digamma(const Uncertain<T, D>& a) {
+    return digamma(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> digamma(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Digamma{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(const Uncertain<T, D>& a, const Uncertain<T, D>& b) {
+    auto [mean, dcda, dcdb] = kernels::Beta{}(a.mean(), b.mean());
+    return detail_::binary_result(a, b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(Uncertain<T, D>&& a, const Uncertain<T, D>& b) {
+    auto [mean, dcda, dcdb] = kernels::Beta{}(a.mean(), b.mean());
+    return detail_::binary_result(std::move(a), b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(const Uncertain<T, D>& a, Uncertain<T, D>&& b) {
+    auto [mean, dcda, dcdb] = kernels::Beta{}(a.mean(), b.mean());
+    return detail_::binary_result(a, std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(Uncertain<T, D>&& a, Uncertain<T, D>&& b) {
+    auto [mean, dcda, dcdb] = kernels::Beta{}(a.mean(), b.mean());
+    return detail_::binary_result(std::move(a), std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(const Uncertain<T, D>& a, double b) {
+    return beta(Uncertain<T, D>(a), b);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(Uncertain<T, D>&& a, double b) {
+    auto [mean, dcda, dcdb] = kernels::Beta{}(a.mean(), static_cast<T>(b));
+    return detail_::unary_result(std::move(a), mean, dcda);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(double a, const Uncertain<T, D>& b) {
+    return beta(a, Uncertain<T, D>(b));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> beta(double a, Uncertain<T, D>&& b) {
+    auto [mean, dcda, dcdb] = kernels::Beta{}(static_cast<T>(a), b.mean());
+    return detail_::unary_result(std::move(b), mean, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(const Uncertain<T, D>& a, const Uncertain<T, D>& b) {
+    auto [mean, dcda, dcdb] = kernels::Lbeta{}(a.mean(), b.mean());
+    return detail_::binary_result(a, b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(Uncertain<T, D>&& a, const Uncertain<T, D>& b) {
+    auto [mean, dcda, dcdb] = kernels::Lbeta{}(a.mean(), b.mean());
+    return detail_::binary_result(std::move(a), b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(const Uncertain<T, D>& a, Uncertain<T, D>&& b) {
+    auto [mean, dcda, dcdb] = kernels::Lbeta{}(a.mean(), b.mean());
+    return detail_::binary_result(a, std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(Uncertain<T, D>&& a, Uncertain<T, D>&& b) {
+    auto [mean, dcda, dcdb] = kernels::Lbeta{}(a.mean(), b.mean());
+    return detail_::binary_result(std::move(a), std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(const Uncertain<T, D>& a, double b) {
+    return lbeta(Uncertain<T, D>(a), b);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(Uncertain<T, D>&& a, double b) {
+    auto [mean, dcda, dcdb] = kernels::Lbeta{}(a.mean(), static_cast<T>(b));
+    return detail_::unary_result(std::move(a), mean, dcda);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(double a, const Uncertain<T, D>& b) {
+    return lbeta(a, Uncertain<T, D>(b));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> lbeta(double a, Uncertain<T, D>&& b) {
+    auto [mean, dcda, dcdb] = kernels::Lbeta{}(static_cast<T>(a), b.mean());
+    return detail_::unary_result(std::move(b), mean, dcdb);
 }
 
 } // namespace sigma
@@ -10,6 +10,7 @@ namespace sigma {
 /** @brief Exponentiation of a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of the exponent
  *  @param a The base variable
  *  @param exp The exponent to raise the base by
@@ -18,12 +19,16 @@ namespace sigma {
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> pow(const Uncertain<T>& a, const U& exp);
+template<typename T, typename D, typename U>
+Uncertain<T, D> pow(const Uncertain<T, D>& a, const U& exp);
+/** @overload */
+template<typename T, typename D, typename U>
+Uncertain<T, D> pow(Uncertain<T, D>&& a, const U& exp);
 
 /** @brief Exponentiation of a variable by an uncertain variable
  *
  *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
  *  @param a The base variable
  *  @param exp The uncertain exponent to raise the base by
  *
@@ -31,62 +36,88 @@ Uncertain<T> pow(const Uncertain<T>& a, const U& exp);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> pow(const Uncertain<T>& a, const Uncertain<T>& exp);
+template<typename T, typename D>
+Uncertain<T, D> pow(const Uncertain<T, D>& a, const Uncertain<T, D>& exp);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> pow(Uncertain<T, D>&& a, const Uncertain<T, D>& exp);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> pow(const Uncertain<T, D>& a, Uncertain<T, D>&& exp);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> pow(Uncertain<T, D>&& a, Uncertain<T, D>&& exp);
 
 /** @brief Calculate the square root of an uncertain variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose root is computed
  *
  *  @return A variable whose value is the square root of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> sqrt(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> sqrt(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> sqrt(Uncertain<T, D>&& a);
 
 /** @brief Calculate the cube root of an uncertain variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose root is computed
  *
  *  @return A variable whose value is the cube root of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> cbrt(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> cbrt(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> cbrt(Uncertain<T, D>&& a);
 
 /** @brief Calculate the Euler's number raised to the power of an uncertain
  *         variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable that is the exponent
  *
  *  @return A variable whose value is Euler's number raised by the mean of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> exp(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> exp(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> exp(Uncertain<T, D>&& a);
 
 /** @brief Calculate 2 raised to the power of an uncertain variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable that is the exponent
  *
  *  @return A variable whose value is 2 raised by the mean of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> exp2(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> exp2(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> exp2(Uncertain<T, D>&& a);
 
 /** @brief Calculate the Euler's number raised to the power of an uncertain
  *         variable, then subtract 1.
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable that is the exponent
  *
  *  @return A variable whose value is Euler's number raised by the mean of @p a,
@@ -94,60 +125,80 @@ Uncertain<T> exp2(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> expm1(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> expm1(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> expm1(Uncertain<T, D>&& a);
 
 /** @brief Calculate the natural logarithm of a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose logarithm is determined
  *
  *  @return A variable whose value is the natural logarithm of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> log(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> log(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> log(Uncertain<T, D>&& a);
 
 /** @brief Calculate the base 10 logarithm of a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose logarithm is determined
  *
  *  @return A variable whose value is the base 10 logarithm of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> log10(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> log10(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> log10(Uncertain<T, D>&& a);
 
 /** @brief Calculate the base 2 logarithm of a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose logarithm is determined
  *
  *  @return A variable whose value is the base 2 logarithm of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> log2(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> log2(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> log2(Uncertain<T, D>&& a);
 
 /** @brief Calculate the natural logarithm of one plus a variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable whose logarithm is determined
  *
  *  @return A variable whose value is the natural logarithm of @p a + 1
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> log1p(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> log1p(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> log1p(Uncertain<T, D>&& a);
 
 /** @brief Calculate the square root of the sum of squared arguments
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The first variable
  *  @param b The second variable
  *
@@ -155,12 +206,22 @@ Uncertain<T> log1p(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> hypot(const Uncertain<T>& a, const Uncertain<T>& b);
+template<typename T, typename D>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> hypot(Uncertain<T, D>&& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, Uncertain<T, D>&& b);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> hypot(Uncertain<T, D>&& a, Uncertain<T, D>&& b);
 
 /** @brief Calculate the square root of the sum of squared arguments
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of @p b
  *  @param a The first variable
  *  @param b The second variable
@@ -169,12 +230,16 @@ Uncertain<T> hypot(const Uncertain<T>& a, const Uncertain<T>& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> hypot(const Uncertain<T>& a, const U& b);
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, const U& b);
+/** @overload */
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(Uncertain<T, D>&& a, const U& b);
 
 /** @brief Calculate the square root of the sum of squared arguments
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of @p a
  *  @param a The first variable
  *  @param b The second variable
@@ -183,8 +248,29 @@ Uncertain<T> hypot(const Uncertain<T>& a, const U& b);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> hypot(const U& a, const Uncertain<T>& b);
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(const U& a, const Uncertain<T, D>& b);
+/** @overload */
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(const U& a, Uncertain<T, D>&& b);
+
+/** @brief Calculate the square root of the sum of three squared arguments
+ *
+ *  @tparam T The value type of the variables
+ *  @tparam D The dependency storage type of the variables
+ *  @param a The first variable
+ *  @param b The second variable
+ *  @param c The third variable
+ *
+ *  @return A variable that is the square root of the sum of the squares of
+ *          @p a, @p b and @p c
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename D>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                      const Uncertain<T, D>& c);
 
 } // namespace sigma
 
@@ -1,106 +1,211 @@
 #pragma once
 
 #include "sigma/detail_/operation_common.hpp"
+#include "sigma/kernels.hpp"
+#include <array>
 #include <cmath>
 
 namespace sigma {
 
-template<typename T, typename U>
-Uncertain<T> pow(const Uncertain<T>& a, const U& exp) {
+template<typename T, typename D, typename U>
+Uncertain<T, D> pow(const Uncertain<T, D>& a, const U& exp) {
+    return pow(Uncertain<T, D>(a), exp);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> pow(Uncertain<T, D>&& a, const U& exp) {
     T mean = std::pow(a.mean(), exp);
     T dcda = exp * std::pow(a.mean(), exp - 1);
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> pow(const Uncertain<T>& a, const Uncertain<T>& exp) {
+template<typename T, typename D>
+Uncertain<T, D> pow(const Uncertain<T, D>& a, const Uncertain<T, D>& exp) {
     T mean = std::pow(a.mean(), exp.mean());
     T dcda = exp.mean() * std::pow(a.mean(), exp.mean() - 1);
     T dcdb = std::log(a.mean()) * std::pow(a.mean(), exp.mean());
     return detail_::binary_result(a, exp, mean, dcda, dcdb);
 }
 
-template<typename T>
-Uncertain<T> sqrt(const Uncertain<T>& a) {
-    T mean = std::sqrt(a.mean());
-    T dcda = 1.0 / (2.0 * std::sqrt(a.mean()));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> pow(Uncertain<T, D>&& a, const Uncertain<T, D>& exp) {
+    T mean = std::pow(a.mean(), exp.mean());
+    T dcda = exp.mean() * std::pow(a.mean(), exp.mean() - 1);
+    T dcdb = std::log(a.mean()) * std::pow(a.mean(), exp.mean());
+    return detail_::binary_result(std::move(a), exp, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> pow(const Uncertain<T, D>& a, Uncertain<T, D>&& exp) {
+    T mean = std::pow(a.mean(), exp.mean());
+    T dcda = exp.mean() * std::pow(a.mean(), exp.mean() - 1);
+    T dcdb = std::log(a.mean()) * std::pow(a.mean(), exp.mean());
+    return detail_::binary_result(a, std::move(exp), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> pow(Uncertain<T, D>&& a, Uncertain<T, D>&& exp) {
+    T mean = std::pow(a.mean(), exp.mean());
+    T dcda = exp.mean() * std::pow(a.mean(), exp.mean() - 1);
+    T dcdb = std::log(a.mean()) * std::pow(a.mean(), exp.mean());
+    return detail_::binary_result(std::move(a), std::move(exp), mean, dcda,
+                                  dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> sqrt(const Uncertain<T, D>& a) {
+    return sqrt(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> sqrt(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Sqrt{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> cbrt(const Uncertain<T, D>& a) {
+    return cbrt(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> cbrt(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Cbrt{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> exp(const Uncertain<T, D>& a) {
+    return exp(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> exp(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Exp{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> exp2(const Uncertain<T, D>& a) {
+    return exp2(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> exp2(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Exp2{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> expm1(const Uncertain<T, D>& a) {
+    return expm1(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> expm1(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Expm1{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> cbrt(const Uncertain<T>& a) {
-    T mean = std::cbrt(a.mean());
-    T dcda = 1.0 / (3.0 * std::cbrt(std::pow(a.mean(), 2.0)));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log(const Uncertain<T, D>& a) {
+    return log(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> exp(const Uncertain<T>& a) {
-    T mean = std::exp(a.mean());
-    T dcda = std::exp(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Log{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> exp2(const Uncertain<T>& a) {
-    T mean = std::exp2(a.mean());
-    T dcda = mean * std::log(2.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log10(const Uncertain<T, D>& a) {
+    return log10(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> expm1(const Uncertain<T>& a) {
-    T mean = std::expm1(a.mean());
-    T dcda = std::exp(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log10(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Log10{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> log(const Uncertain<T>& a) {
-    T mean = std::log(a.mean());
-    T dcda = 1.0 / a.mean();
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log2(const Uncertain<T, D>& a) {
+    return log2(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> log10(const Uncertain<T>& a) {
-    T mean = std::log10(a.mean());
-    T dcda = 1.0 / (a.mean() * std::log(10.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log2(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Log2{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> log2(const Uncertain<T>& a) {
-    T mean = std::log2(a.mean());
-    T dcda = 1.0 / (a.mean() * std::log(2.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log1p(const Uncertain<T, D>& a) {
+    return log1p(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> log1p(const Uncertain<T>& a) {
-    T mean = std::log1p(a.mean());
-    T dcda = 1.0 / (a.mean() + 1.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> log1p(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Log1p{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> hypot(const Uncertain<T>& a, const Uncertain<T>& b) {
+template<typename T, typename D>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, const Uncertain<T, D>& b) {
     T mean = std::hypot(a.mean(), b.mean());
     T dcda = a.mean() / std::hypot(a.mean(), b.mean());
     T dcdb = b.mean() / std::hypot(a.mean(), b.mean());
     return detail_::binary_result(a, b, mean, dcda, dcdb);
 }
 
-template<typename T, typename U>
-Uncertain<T> hypot(const Uncertain<T>& a, const U& b) {
+template<typename T, typename D>
+Uncertain<T, D> hypot(Uncertain<T, D>&& a, const Uncertain<T, D>& b) {
+    T mean = std::hypot(a.mean(), b.mean());
+    T dcda = a.mean() / std::hypot(a.mean(), b.mean());
+    T dcdb = b.mean() / std::hypot(a.mean(), b.mean());
+    return detail_::binary_result(std::move(a), b, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, Uncertain<T, D>&& b) {
+    T mean = std::hypot(a.mean(), b.mean());
+    T dcda = a.mean() / std::hypot(a.mean(), b.mean());
+    T dcdb = b.mean() / std::hypot(a.mean(), b.mean());
+    return detail_::binary_result(a, std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> hypot(Uncertain<T, D>&& a, Uncertain<T, D>&& b) {
+    T mean = std::hypot(a.mean(), b.mean());
+    T dcda = a.mean() / std::hypot(a.mean(), b.mean());
+    T dcdb = b.mean() / std::hypot(a.mean(), b.mean());
+    return detail_::binary_result(std::move(a), std::move(b), mean, dcda, dcdb);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, const U& b) {
+    return hypot(Uncertain<T, D>(a), b);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(Uncertain<T, D>&& a, const U& b) {
     T mean = std::hypot(a.mean(), b);
     T dcda = a.mean() / std::hypot(a.mean(), b);
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
 }
 
-template<typename T, typename U>
-Uncertain<T> hypot(const U& a, const Uncertain<T>& b) {
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(const U& a, const Uncertain<T, D>& b) {
     return hypot(b, a);
 }
 
+template<typename T, typename D, typename U>
+Uncertain<T, D> hypot(const U& a, Uncertain<T, D>&& b) {
+    return hypot(std::move(b), a);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> hypot(const Uncertain<T, D>& a, const Uncertain<T, D>& b,
+                      const Uncertain<T, D>& c) {
+    T mean = std::hypot(a.mean(), b.mean(), c.mean());
+    T dcda = a.mean() / mean;
+    T dcdb = b.mean() / mean;
+    T dcdc = c.mean() / mean;
+    std::array<detail_::operand_t<Uncertain<T, D>>, 3> operands{
+      {{&a, dcda}, {&b, dcdb}, {&c, dcdc}}};
+    return detail_::nary_result(mean, operands);
+}
+
 } // namespace sigma
@@ -10,74 +10,98 @@ namespace sigma {
 /** @brief Hyperbolic sine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic sine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> sinh(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> sinh(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> sinh(Uncertain<T, D>&& a);
 
 /** @brief Hyperbolic cosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic cosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> cosh(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> cosh(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> cosh(Uncertain<T, D>&& a);
 
 /** @brief Hyperbolic tangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic tangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> tanh(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> tanh(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> tanh(Uncertain<T, D>&& a);
 
 /** @brief Hyperbolic arcsine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic arcsine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> asinh(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> asinh(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> asinh(Uncertain<T, D>&& a);
 
 /** @brief Hyperbolic arccosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic arccosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> acosh(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> acosh(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> acosh(Uncertain<T, D>&& a);
 
 /** @brief Hyperbolic arctangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the hyperbolic arctangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> atanh(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> atanh(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> atanh(Uncertain<T, D>&& a);
 
 } // namespace sigma
 
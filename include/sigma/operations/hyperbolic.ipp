@@ -1,50 +1,69 @@
 #pragma once
 
 #include "sigma/detail_/operation_common.hpp"
+#include "sigma/kernels.hpp"
 #include <cmath>
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> sinh(const Uncertain<T>& a) {
-    T mean = std::sinh(a.mean());
-    T dcda = std::cosh(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> sinh(const Uncertain<T, D>& a) {
+    return sinh(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> cosh(const Uncertain<T>& a) {
-    T mean = std::cosh(a.mean());
-    T dcda = std::sinh(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> sinh(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Sinh{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> tanh(const Uncertain<T>& a) {
-    T mean = std::tanh(a.mean());
-    T dcda = 1.0 - std::pow(std::tanh(a.mean()), 2.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> cosh(const Uncertain<T, D>& a) {
+    return cosh(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> asinh(const Uncertain<T>& a) {
-    T mean = std::asinh(a.mean());
-    T dcda = 1.0 / std::sqrt(1 + std::pow(a.mean(), 2.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> cosh(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Cosh{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> acosh(const Uncertain<T>& a) {
-    T mean = std::acosh(a.mean());
-    T dcda = 1.0 / std::sqrt(std::pow(a.mean(), 2.0) - 1.0);
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> tanh(const Uncertain<T, D>& a) {
+    return tanh(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> atanh(const Uncertain<T>& a) {
-    T mean = std::atanh(a.mean());
-    T dcda = 1.0 / (1.0 - std::pow(a.mean(), 2.0));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> tanh(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Tanh{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> asinh(const Uncertain<T, D>& a) {
+    return asinh(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> asinh(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Asinh{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> acosh(const Uncertain<T, D>& a) {
+    return acosh(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> acosh(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Acosh{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> atanh(const Uncertain<T, D>& a) {
+    return atanh(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> atanh(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Atanh{}, std::move(a));
 }
 
 } // namespace sigma
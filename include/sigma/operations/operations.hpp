@@ -5,6 +5,8 @@
 #include "error_and_gamma.hpp"
 #include "exponents.hpp"
 #include "hyperbolic.hpp"
+#include "polynomial.hpp"
+#include "reductions.hpp"
 #include "trigonometry.hpp"
 
 /** @file operations.hpp
@@ -0,0 +1,33 @@
+#pragma once
+#include "sigma/uncertain.hpp"
+
+/** @file polynomial.hpp
+ *  @brief Polynomial operations for uncertain variables
+ */
+
+namespace sigma {
+
+/** @brief Evaluate a polynomial
+ *
+ *  The polynomial `c[0] + c[1] * x + c[2] * x^2 + ...` is evaluated with
+ *  Horner's scheme, along with its derivative, and the dependencies of the
+ *  result are formed in a single merge rather than one per term.
+ *
+ *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
+ *  @tparam Coefficients The type of the container of coefficients, whose
+ *                       elements are either numbers or Uncertain<T, D>
+ *  @param c The coefficients, in order of increasing degree
+ *  @param x The variable the polynomial is evaluated at
+ *
+ *  @return The value of the polynomial at @p x
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename T, typename D, typename Coefficients>
+Uncertain<T, D> polyval(const Coefficients& c, const Uncertain<T, D>& x);
+
+} // namespace sigma
+
+#include "polynomial.ipp"
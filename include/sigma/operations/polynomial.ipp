@@ -0,0 +1,43 @@
+#pragma once
+
+#include "sigma/detail_/operation_common.hpp"
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+#include <vector>
+
+namespace sigma {
+
+template<typename T, typename D, typename Coefficients>
+Uncertain<T, D> polyval(const Coefficients& c, const Uncertain<T, D>& x) {
+    using uncertain_t   = Uncertain<T, D>;
+    using coefficient_t = std::decay_t<decltype(*std::begin(c))>;
+    constexpr bool uncertain_coefficients =
+      std::is_same_v<coefficient_t, uncertain_t>;
+
+    // Horner's scheme for the value and the derivative, from the top down
+    T mean = 0.0;
+    T dcdx = 0.0;
+    for(auto ci = std::rbegin(c); ci != std::rend(c); ++ci) {
+        dcdx = dcdx * x.mean() + mean;
+        mean = mean * x.mean() + detail_::mean_of(*ci);
+    }
+
+    if constexpr(uncertain_coefficients) {
+        // The derivative with respect to c[i] is x^i
+        std::pmr::vector<detail_::operand_t<uncertain_t>> operands(
+          sigma::get_memory_resource());
+        operands.reserve(std::size(c) + 1);
+        operands.emplace_back(&x, dcdx);
+        T dcdci = 1.0;
+        for(const auto& ci : c) {
+            operands.emplace_back(&ci, dcdci);
+            dcdci *= x.mean();
+        }
+        return detail_::nary_result(mean, operands);
+    } else {
+        return detail_::unary_result(x, mean, dcdx);
+    }
+}
+
+} // namespace sigma
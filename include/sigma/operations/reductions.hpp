@@ -0,0 +1,110 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/uncertain.hpp"
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+/** @file reductions.hpp
+ *  @brief Reductions over ranges of uncertain variables
+ *
+ *  Accumulating a range one operation at a time merges the growing set of
+ *  dependencies of the partial result with each element in turn, which
+ *  costs time quadratic in the size of the range. The reductions here
+ *  instead combine the dependencies of all of the elements at once, with a
+ *  single k-way merge, and so take close to linear time.
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/** @brief The type of the elements of a range
+ *
+ *  @tparam Range The type of the range
+ */
+template<typename Range>
+using range_element_t =
+  std::decay_t<decltype(*std::begin(std::declval<const Range&>()))>;
+
+/** @brief The type of the variables in one of several ranges
+ *
+ *  @tparam Ranges The types of the ranges
+ */
+template<typename... Ranges>
+using uncertain_range_t =
+  typename first_uncertain<range_element_t<Ranges>...>::type;
+
+} // namespace detail_
+
+/** @brief Sum of a range of variables
+ *
+ *  @tparam Range The type of the range
+ *  @param values The variables
+ *
+ *  @return A variable that is the sum of @p values
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename Range>
+detail_::uncertain_range_t<Range> sum(const Range& values);
+
+/** @brief Arithmetic mean of a range of variables
+ *
+ *  @tparam Range The type of the range
+ *  @param values The variables. If there are none, the mean is NaN.
+ *
+ *  @return A variable that is the mean of @p values
+ *
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename Range>
+detail_::uncertain_range_t<Range> mean(const Range& values);
+
+/** @brief Dot product of two ranges
+ *
+ *  Either range may hold plain numbers, in which case this is a weighted
+ *  sum of the variables in the other.
+ *
+ *  @tparam Range1 The type of the first range
+ *  @tparam Range2 The type of the second range
+ *  @param a The first range
+ *  @param b The second range
+ *
+ *  @return A variable that is the sum of the products of the elements of
+ *          @p a and @p b
+ *
+ *  @throw std::invalid_argument if the ranges differ in size. Strong throw
+ *         guarantee.
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename Range1, typename Range2>
+detail_::uncertain_range_t<Range1, Range2> dot(const Range1& a,
+                                               const Range2& b);
+
+/** @brief Weighted arithmetic mean of a range of variables
+ *
+ *  The weights may be plain numbers or variables themselves.
+ *
+ *  @tparam Range1 The type of the range of variables
+ *  @tparam Range2 The type of the range of weights
+ *  @param values The variables
+ *  @param weights The weights of the variables
+ *
+ *  @return A variable that is the sum of the products of @p values and
+ *          @p weights, divided by the sum of @p weights
+ *
+ *  @throw std::invalid_argument if the ranges differ in size. Strong throw
+ *         guarantee.
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename Range1, typename Range2>
+detail_::uncertain_range_t<Range1, Range2> weighted_mean(
+  const Range1& values, const Range2& weights);
+
+} // namespace sigma
+
+#include "reductions.ipp"
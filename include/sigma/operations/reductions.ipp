@@ -0,0 +1,144 @@
+#pragma once
+
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/memory_resource.hpp"
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <vector>
+
+namespace sigma {
+namespace detail_ {
+
+/** @brief Check that two ranges have the same size
+ *
+ *  @param a The first range
+ *  @param b The second range
+ *
+ *  @return The size of the ranges
+ *
+ *  @throw std::invalid_argument if the ranges differ in size. Strong throw
+ *         guarantee.
+ */
+template<typename Range1, typename Range2>
+std::size_t common_size(const Range1& a, const Range2& b) {
+    auto n = static_cast<std::size_t>(std::size(a));
+    if(n != static_cast<std::size_t>(std::size(b))) {
+        throw std::invalid_argument("The ranges differ in size");
+    }
+    return n;
+}
+
+/** @brief Add an operand to those of an n-ary operation, if it is uncertain
+ *
+ *  @param operands The operands of the operation
+ *  @param x The possible operand
+ *  @param dcdx The partial derivative with respect to @p x
+ *
+ *  @throw std::bad_alloc if growing @p operands fails. Strong throw
+ *         guarantee.
+ */
+template<typename Operands, typename T, typename U>
+void add_operand(Operands& operands, const T& x, U dcdx) {
+    if constexpr(is_uncertain<T>::value) operands.emplace_back(&x, dcdx);
+}
+
+/// Container for the operands of a reduction
+template<typename UncertainType>
+using reduction_operands_t = std::pmr::vector<operand_t<UncertainType>>;
+
+} // namespace detail_
+
+template<typename Range>
+detail_::uncertain_range_t<Range> sum(const Range& values) {
+    using uncertain_t = detail_::uncertain_range_t<Range>;
+    using value_t     = typename uncertain_t::value_t;
+    detail_::reduction_operands_t<uncertain_t> operands(
+      sigma::get_memory_resource());
+    operands.reserve(std::size(values));
+    value_t mean = 0.0;
+    for(const auto& x : values) {
+        mean += x.mean();
+        operands.emplace_back(&x, value_t{1.0});
+    }
+    return detail_::nary_result(mean, operands);
+}
+
+template<typename Range>
+detail_::uncertain_range_t<Range> mean(const Range& values) {
+    using uncertain_t = detail_::uncertain_range_t<Range>;
+    using value_t     = typename uncertain_t::value_t;
+    auto n            = std::size(values);
+    if(n == 0) return uncertain_t(std::numeric_limits<value_t>::quiet_NaN());
+
+    value_t dcdx = value_t{1.0} / static_cast<value_t>(n);
+    detail_::reduction_operands_t<uncertain_t> operands(
+      sigma::get_memory_resource());
+    operands.reserve(n);
+    value_t total = 0.0;
+    for(const auto& x : values) {
+        total += x.mean();
+        operands.emplace_back(&x, dcdx);
+    }
+    return detail_::nary_result(total * dcdx, operands);
+}
+
+template<typename Range1, typename Range2>
+detail_::uncertain_range_t<Range1, Range2> dot(const Range1& a,
+                                               const Range2& b) {
+    using uncertain_t = detail_::uncertain_range_t<Range1, Range2>;
+    using value_t     = typename uncertain_t::value_t;
+    auto n            = detail_::common_size(a, b);
+
+    detail_::reduction_operands_t<uncertain_t> operands(
+      sigma::get_memory_resource());
+    operands.reserve(2 * n);
+    value_t mean = 0.0;
+    auto bi      = std::begin(b);
+    for(const auto& ai : a) {
+        value_t a_mean = detail_::mean_of(ai);
+        value_t b_mean = detail_::mean_of(*bi);
+        mean += a_mean * b_mean;
+        detail_::add_operand(operands, ai, b_mean);
+        detail_::add_operand(operands, *bi, a_mean);
+        ++bi;
+    }
+    return detail_::nary_result(mean, operands);
+}
+
+template<typename Range1, typename Range2>
+detail_::uncertain_range_t<Range1, Range2> weighted_mean(
+  const Range1& values, const Range2& weights) {
+    using uncertain_t = detail_::uncertain_range_t<Range1, Range2>;
+    using value_t     = typename uncertain_t::value_t;
+    auto n            = detail_::common_size(values, weights);
+
+    value_t weighted_total = 0.0;
+    value_t total_weight   = 0.0;
+    auto wi                = std::begin(weights);
+    for(const auto& xi : values) {
+        value_t w = detail_::mean_of(*wi);
+        weighted_total += w * detail_::mean_of(xi);
+        total_weight += w;
+        ++wi;
+    }
+    value_t mean = weighted_total / total_weight;
+
+    // The derivatives are w_i / W for x_i and (x_i - mean) / W for w_i
+    detail_::reduction_operands_t<uncertain_t> operands(
+      sigma::get_memory_resource());
+    operands.reserve(2 * n);
+    wi = std::begin(weights);
+    for(const auto& xi : values) {
+        value_t w = detail_::mean_of(*wi);
+        detail_::add_operand(operands, xi, w / total_weight);
+        detail_::add_operand(operands, *wi,
+                             (detail_::mean_of(xi) - mean) / total_weight);
+        ++wi;
+    }
+    return detail_::nary_result(mean, operands);
+}
+
+} // namespace sigma
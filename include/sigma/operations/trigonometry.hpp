@@ -10,102 +10,135 @@ namespace sigma {
 /** @brief Convert from radians to degrees
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The variable @p a in degrees
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> degrees(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> degrees(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> degrees(Uncertain<T, D>&& a);
 
 /** @brief Convert from degrees to radians
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return The variable @p a in radians
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> radians(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> radians(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> radians(Uncertain<T, D>&& a);
 
 /** @brief Sine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the sine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> sin(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> sin(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> sin(Uncertain<T, D>&& a);
 
 /** @brief Cosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the cosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> cos(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> cos(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> cos(Uncertain<T, D>&& a);
 
 /** @brief Tangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the tangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> tan(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> tan(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> tan(Uncertain<T, D>&& a);
 
 /** @brief Arcsine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the arcsine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> asin(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> asin(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> asin(Uncertain<T, D>&& a);
 
 /** @brief Arccosine of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the arccosine value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> acos(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> acos(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> acos(Uncertain<T, D>&& a);
 
 /** @brief Arctangent of the variable
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param a The variable
  *
  *  @return A variable that is the arctangent value of @p a
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> atan(const Uncertain<T>& a);
+template<typename T, typename D>
+Uncertain<T, D> atan(const Uncertain<T, D>& a);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> atan(Uncertain<T, D>&& a);
 
 /** @brief Two argument arctangent
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @param y The first variable
  *  @param x The first variable
  *
@@ -113,12 +146,22 @@ Uncertain<T> atan(const Uncertain<T>& a);
  *
  *  @throw none No throw guarantee
  */
-template<typename T>
-Uncertain<T> atan2(const Uncertain<T>& y, const Uncertain<T>& x);
+template<typename T, typename D>
+Uncertain<T, D> atan2(const Uncertain<T, D>& y, const Uncertain<T, D>& x);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> atan2(Uncertain<T, D>&& y, const Uncertain<T, D>& x);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> atan2(const Uncertain<T, D>& y, Uncertain<T, D>&& x);
+/** @overload */
+template<typename T, typename D>
+Uncertain<T, D> atan2(Uncertain<T, D>&& y, Uncertain<T, D>&& x);
 
 /** @brief Two argument arctangent
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of @p x
  *  @param y The first variable
  *  @param x The first variable
@@ -127,12 +170,16 @@ Uncertain<T> atan2(const Uncertain<T>& y, const Uncertain<T>& x);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> atan2(const Uncertain<T>& y, const U& x);
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(const Uncertain<T, D>& y, const U& x);
+/** @overload */
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(Uncertain<T, D>&& y, const U& x);
 
 /** @brief Two argument arctangent
  *
  *  @tparam T The value type of the variable
+ *  @tparam D The dependency storage type of the variable
  *  @tparam U The numeric type of @p y
  *  @param y The first variable
  *  @param x The first variable
@@ -141,8 +188,11 @@ Uncertain<T> atan2(const Uncertain<T>& y, const U& x);
  *
  *  @throw none No throw guarantee
  */
-template<typename T, typename U>
-Uncertain<T> atan2(const U& y, const Uncertain<T>& x);
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(const U& y, const Uncertain<T, D>& x);
+/** @overload */
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(const U& y, Uncertain<T, D>&& x);
 
 } // namespace sigma
 
@@ -1,87 +1,150 @@
 #pragma once
 #include "sigma/detail_/operation_common.hpp"
+#include "sigma/kernels.hpp"
 #include <cmath>
 
 namespace sigma {
 
-template<typename T>
-Uncertain<T> degrees(const Uncertain<T>& a) {
+template<typename T, typename D>
+Uncertain<T, D> degrees(const Uncertain<T, D>& a) {
+    return degrees(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> degrees(Uncertain<T, D>&& a) {
     auto to_degrees = 180.0 / detail_::pi;
     T mean          = a.mean() * to_degrees;
     T dcda          = to_degrees;
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
 }
 
-template<typename T>
-Uncertain<T> radians(const Uncertain<T>& a) {
+template<typename T, typename D>
+Uncertain<T, D> radians(const Uncertain<T, D>& a) {
+    return radians(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> radians(Uncertain<T, D>&& a) {
     auto to_radians = detail_::pi / 180.0;
     T mean          = a.mean() * to_radians;
     T dcda          = to_radians;
-    return detail_::unary_result(a, mean, dcda);
+    return detail_::unary_result(std::move(a), mean, dcda);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> sin(const Uncertain<T, D>& a) {
+    return sin(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> sin(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Sin{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> cos(const Uncertain<T, D>& a) {
+    return cos(Uncertain<T, D>(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> cos(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Cos{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> tan(const Uncertain<T, D>& a) {
+    return tan(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> sin(const Uncertain<T>& a) {
-    T mean = std::sin(a.mean());
-    T dcda = std::cos(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> tan(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Tan{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> cos(const Uncertain<T>& a) {
-    T mean = std::cos(a.mean());
-    T dcda = -std::sin(a.mean());
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> asin(const Uncertain<T, D>& a) {
+    return asin(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> tan(const Uncertain<T>& a) {
-    T mean = std::tan(a.mean());
-    T dcda = std::pow(std::tan(a.mean()), 2.0) + 1;
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> asin(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Asin{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> asin(const Uncertain<T>& a) {
-    T mean = std::asin(a.mean());
-    T dcda = 1 / std::sqrt(1 - std::pow(a.mean(), 2));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> acos(const Uncertain<T, D>& a) {
+    return acos(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> acos(const Uncertain<T>& a) {
-    T mean = std::acos(a.mean());
-    T dcda = -1 / std::sqrt(1 - std::pow(a.mean(), 2));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> acos(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Acos{}, std::move(a));
 }
 
-template<typename T>
-Uncertain<T> atan(const Uncertain<T>& a) {
-    T mean = std::atan(a.mean());
-    T dcda = 1 / (1 + std::pow(a.mean(), 2));
-    return detail_::unary_result(a, mean, dcda);
+template<typename T, typename D>
+Uncertain<T, D> atan(const Uncertain<T, D>& a) {
+    return atan(Uncertain<T, D>(a));
 }
 
-template<typename T>
-Uncertain<T> atan2(const Uncertain<T>& y, const Uncertain<T>& x) {
+template<typename T, typename D>
+Uncertain<T, D> atan(Uncertain<T, D>&& a) {
+    return detail_::kernel_result(kernels::Atan{}, std::move(a));
+}
+
+template<typename T, typename D>
+Uncertain<T, D> atan2(const Uncertain<T, D>& y, const Uncertain<T, D>& x) {
     T mean = std::atan2(y.mean(), x.mean());
     T dcda = x.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
     T dcdb = -y.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
     return detail_::binary_result(y, x, mean, dcda, dcdb);
 }
 
-template<typename T, typename U>
-Uncertain<T> atan2(const Uncertain<T>& y, const U& x) {
+template<typename T, typename D>
+Uncertain<T, D> atan2(Uncertain<T, D>&& y, const Uncertain<T, D>& x) {
+    T mean = std::atan2(y.mean(), x.mean());
+    T dcda = x.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
+    T dcdb = -y.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
+    return detail_::binary_result(std::move(y), x, mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> atan2(const Uncertain<T, D>& y, Uncertain<T, D>&& x) {
+    T mean = std::atan2(y.mean(), x.mean());
+    T dcda = x.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
+    T dcdb = -y.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
+    return detail_::binary_result(y, std::move(x), mean, dcda, dcdb);
+}
+
+template<typename T, typename D>
+Uncertain<T, D> atan2(Uncertain<T, D>&& y, Uncertain<T, D>&& x) {
+    T mean = std::atan2(y.mean(), x.mean());
+    T dcda = x.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
+    T dcdb = -y.mean() / (std::pow(x.mean(), 2) + std::pow(y.mean(), 2));
+    return detail_::binary_result(std::move(y), std::move(x), mean, dcda, dcdb);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(const Uncertain<T, D>& y, const U& x) {
+    return atan2(Uncertain<T, D>(y), x);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(Uncertain<T, D>&& y, const U& x) {
     T mean = std::atan2(y.mean(), x);
     T dcda = x / (std::pow(x, 2) + std::pow(y.mean(), 2));
-    return detail_::unary_result(y, mean, dcda);
+    return detail_::unary_result(std::move(y), mean, dcda);
+}
+
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(const U& y, const Uncertain<T, D>& x) {
+    return atan2(y, Uncertain<T, D>(x));
 }
 
-template<typename T, typename U>
-Uncertain<T> atan2(const U& y, const Uncertain<T>& x) {
+template<typename T, typename D, typename U>
+Uncertain<T, D> atan2(const U& y, Uncertain<T, D>&& x) {
     T mean = std::atan2(y, x.mean());
     T dcda = -y / (std::pow(x.mean(), 2) + std::pow(y, 2));
-    return detail_::unary_result(x, mean, dcda);
+    return detail_::unary_result(std::move(x), mean, dcda);
 }
 
 } // namespace sigma
@@ -0,0 +1,286 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/dual.hpp"
+#include "sigma/eigen_compat.hpp"
+#include "sigma/lift.hpp"
+#include "sigma/uncertain.hpp"
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+/** @file roots.hpp
+ *  @brief Roots of functions of uncertain parameters
+ *
+ *  The root is found by Newton iterations on the mean values alone, and its
+ *  dependencies are only attached at convergence, by the implicit function
+ *  theorem: if f(x, p) = 0 then dx/dp = -(df/dx)^-1 df/dp. This costs the
+ *  same as a solve on plain numbers plus one gradient, and the uncertainty
+ *  of the root does not depend on the path the iterations took.
+ */
+
+namespace sigma {
+namespace detail_ {
+
+/// The maximum number of iterations of find_root()
+constexpr std::size_t max_root_iterations = 100;
+
+/** @brief Whether a Newton step is small enough to stop
+ *
+ *  @tparam T The numeric type
+ *  @param step The size of the step
+ *  @param x The size of the current estimate of the root
+ *
+ *  @return True if @p step is within a few units in the last place of @p x
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+bool root_converged(T step, T x) {
+    return step <= 8 * std::numeric_limits<T>::epsilon() * (T{1} + x);
+}
+
+/** @brief Iterations of find_root() on the mean values
+ *
+ *  @tparam T The numeric type
+ *  @tparam FunctionType The type of the function
+ *  @tparam Params The types of the parameters
+ *  @param f The function
+ *  @param x The initial guess
+ *  @param params The parameters
+ *
+ *  @return The root of @p f
+ *
+ *  @throw std::runtime_error if the iterations do not converge
+ */
+template<typename T, typename FunctionType, typename... Params>
+T newton_root(FunctionType& f, T x, const Params&... params) {
+    using dual_t = Dual<T, 1>;
+    for(std::size_t i = 0; i < max_root_iterations; ++i) {
+        dual_t fx = f(dual_t::variable(x, 0), dual_t(mean_of(params))...);
+        if(fx.value() == T{0}) return x;
+        T step = fx.value() / fx.derivative(0);
+        if(!std::isfinite(step)) break;
+        x -= step;
+        if(root_converged(std::abs(step), std::abs(x))) return x;
+    }
+    throw std::runtime_error("find_root: Newton iterations did not converge");
+}
+
+/** @brief Implements find_root()
+ *
+ *  @tparam T The numeric type
+ *  @tparam FunctionType The type of the function
+ *  @tparam Is The indices of the parameters
+ *  @tparam Params The types of the parameters
+ *  @param f The function
+ *  @param x0 The initial guess
+ *  @param params The parameters
+ *
+ *  @return The root of @p f
+ */
+template<typename T, typename FunctionType, std::size_t... Is,
+         typename... Params>
+auto find_root_(FunctionType& f, T x0, std::index_sequence<Is...>,
+                const Params&... params) {
+    using dual_t = Dual<T, 1 + sizeof...(Params)>;
+    T x          = newton_root(f, x0, params...);
+
+    dual_t fx = f(dual_t::variable(x, 0),
+                  lift_argument<T, 1 + sizeof...(Params)>(params, Is + 1)...);
+    // The iterations may stop exactly on a root where f is flat
+    if(fx.derivative(0) == T{0} || !std::isfinite(fx.derivative(0))) {
+        throw std::runtime_error(
+          "find_root: the derivative of f vanishes at the root");
+    }
+    auto deriv = [&fx](std::size_t i) {
+        return -fx.derivative(i + 1) / fx.derivative(0);
+    };
+    return gradient_result(x, deriv, std::index_sequence<Is...>{},
+                           params...);
+}
+
+/** @brief The numeric type of the first uncertain type among some types
+ *
+ *  @tparam Ts The types
+ */
+template<typename... Ts>
+using first_uncertain_value_t =
+  typename first_uncertain<Ts...>::type::value_t;
+
+} // namespace detail_
+
+/** @brief Root of a function of uncertain parameters
+ *
+ *  Finds x such that `f(x, params...) == 0` by Newton's method from @p x0,
+ *  iterating on the mean values of @p params only. The derivatives needed
+ *  by the iterations and by the implicit function theorem are taken by
+ *  evaluating @p f on dual numbers, so, as for sigma::lift(), @p f must be
+ *  generic in its arguments.
+ *
+ *  @code
+ *  // The positive root of x^2 - a
+ *  auto root = sigma::find_root([](auto x, auto a) { return x * x - a; },
+ *                               1.0, a);
+ *  @endcode
+ *
+ *  @tparam FunctionType The type of the function
+ *  @tparam Params The types of the parameters. They are the same Uncertain
+ *                 type or plain numbers, and at least one is an Uncertain.
+ *  @param f The function, taking the unknown followed by the parameters
+ *  @param x0 The initial guess
+ *  @param params The parameters
+ *
+ *  @return The root of @p f, depending on the variables @p params depend on
+ *
+ *  @throw std::runtime_error if the iterations do not converge within a
+ *         hundred steps or reach a point where the derivative of @p f
+ *         vanishes. Strong throw guarantee.
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename FunctionType, typename... Params>
+typename detail_::first_uncertain<Params...>::type find_root(
+  FunctionType f, detail_::first_uncertain_value_t<Params...> x0,
+  const Params&... params) {
+    return detail_::find_root_(f, x0, std::index_sequence_for<Params...>{},
+                               params...);
+}
+
+#ifdef ENABLE_EIGEN_SUPPORT
+namespace detail_ {
+
+/** @brief Implements the multidimensional find_root()
+ *
+ *  @tparam T The numeric type
+ *  @tparam N The number of unknowns
+ *  @tparam FunctionType The type of the function
+ *  @tparam Is The indices of the parameters
+ *  @tparam Params The types of the parameters
+ *  @param f The function
+ *  @param x0 The initial guess
+ *  @param params The parameters
+ *
+ *  @return The root of @p f
+ */
+template<typename T, int N, typename FunctionType, std::size_t... Is,
+         typename... Params>
+auto find_root_(FunctionType& f, const Eigen::Matrix<T, N, 1>& x0,
+                std::index_sequence<Is...>, const Params&... params) {
+    static_assert(N != Eigen::Dynamic,
+                  "The number of unknowns must be known at compile time");
+    using uncertain_t = typename first_uncertain<Params...>::type;
+    using vector_t    = Eigen::Matrix<T, N, 1>;
+    using matrix_t    = Eigen::Matrix<T, N, N>;
+
+    // Newton iterations on the mean values
+    using dual_t        = Dual<T, N>;
+    using dual_vector_t = Eigen::Matrix<dual_t, N, 1>;
+    vector_t x          = x0;
+    vector_t fx;
+    matrix_t jacobian;
+    bool converged = false;
+    for(std::size_t i = 0; i < max_root_iterations && !converged; ++i) {
+        dual_vector_t xd;
+        for(int j = 0; j < N; ++j) xd(j) = dual_t::variable(x(j), j);
+        dual_vector_t fd = f(xd, dual_t(mean_of(params))...);
+        for(int j = 0; j < N; ++j) {
+            fx(j) = fd(j).value();
+            for(int k = 0; k < N; ++k) jacobian(j, k) = fd(j).derivative(k);
+        }
+        if(fx.isZero(T{0})) {
+            converged = true;
+            break;
+        }
+        Eigen::FullPivLU<matrix_t> lu(jacobian);
+        if(!lu.isInvertible()) {
+            throw std::runtime_error("find_root: the Jacobian is singular");
+        }
+        vector_t step = lu.solve(fx);
+        if(!step.allFinite()) break;
+        x -= step;
+        converged = root_converged(step.norm(), x.norm());
+    }
+    if(!converged) {
+        throw std::runtime_error(
+          "find_root: Newton iterations did not converge");
+    }
+
+    // Jacobian with respect to the unknowns and the parameters at the root
+    constexpr std::size_t P = sizeof...(Params);
+    using full_dual_t       = Dual<T, N + P>;
+    Eigen::Matrix<full_dual_t, N, 1> xd;
+    for(int j = 0; j < N; ++j) xd(j) = full_dual_t::variable(x(j), j);
+    Eigen::Matrix<full_dual_t, N, 1> fd =
+      f(xd, lift_argument<T, N + P>(params, N + Is)...);
+    Eigen::Matrix<T, N, Eigen::Dynamic> dfdp(N, P);
+    for(int j = 0; j < N; ++j) {
+        for(int k = 0; k < N; ++k) jacobian(j, k) = fd(j).derivative(k);
+        for(std::size_t k = 0; k < P; ++k) dfdp(j, k) = fd(j).derivative(N + k);
+    }
+    Eigen::FullPivLU<matrix_t> lu(jacobian);
+    if(!lu.isInvertible()) {
+        throw std::runtime_error("find_root: the Jacobian is singular");
+    }
+    Eigen::Matrix<T, N, Eigen::Dynamic> dxdp = -lu.solve(dfdp);
+
+    Eigen::Matrix<uncertain_t, N, 1> root;
+    for(int j = 0; j < N; ++j) {
+        auto deriv = [&dxdp, j](std::size_t k) { return dxdp(j, k); };
+        root(j)    = gradient_result(x(j), deriv, std::index_sequence<Is...>{},
+                                     params...);
+    }
+    return root;
+}
+
+} // namespace detail_
+
+/** @brief Root of a system of equations with uncertain parameters
+ *
+ *  The multidimensional counterpart of find_root(): finds the vector x such
+ *  that `f(x, params...)` is the zero vector, by Newton's method from
+ *  @p x0, and attaches the dependencies at convergence by the implicit
+ *  function theorem with the Jacobian of @p f. @p f is called with x as an
+ *  Eigen vector of dual numbers and must return an Eigen vector of the
+ *  same type.
+ *
+ *  @code
+ *  auto f = [](const auto& x, auto a, auto b) {
+ *      std::decay_t<decltype(x)> r;
+ *      r << x(0) * x(1) - a, x(0) - x(1) - b;
+ *      return r;
+ *  };
+ *  Eigen::Vector2d x0(1.0, 1.0);
+ *  auto root = sigma::find_root(f, x0, a, b);
+ *  @endcode
+ *
+ *  @tparam FunctionType The type of the function
+ *  @tparam N The number of unknowns, known at compile time
+ *  @tparam Params The types of the parameters. They are the same Uncertain
+ *                 type or plain numbers, and at least one is an Uncertain.
+ *  @param f The function, taking the unknowns followed by the parameters
+ *  @param x0 The initial guess
+ *  @param params The parameters
+ *
+ *  @return The root of @p f, as an Eigen vector of variables depending on
+ *          the variables @p params depend on
+ *
+ *  @throw std::runtime_error if the iterations do not converge within a
+ *         hundred steps or reach a point where the Jacobian of @p f is
+ *         singular. Strong throw guarantee.
+ *  @throw std::bad_alloc if allocating the dependencies fails. Strong throw
+ *         guarantee.
+ */
+template<typename FunctionType, int N, typename... Params>
+Eigen::Matrix<typename detail_::first_uncertain<Params...>::type, N, 1>
+find_root(FunctionType f,
+          const Eigen::Matrix<detail_::first_uncertain_value_t<Params...>,
+                              N, 1>& x0,
+          const Params&... params) {
+    return detail_::find_root_(f, x0, std::index_sequence_for<Params...>{},
+                               params...);
+}
+#endif // ENABLE_EIGEN_SUPPORT
+
+} // namespace sigma
@@ -1,6 +1,17 @@
 #pragma once
+#include "dual.hpp"
 #include "eigen_compat.hpp"
+#include "expression.hpp"
+#include "fit.hpp"
+#include "graph.hpp"
+#include "kernels.hpp"
+#include "lift.hpp"
+#include "memo.hpp"
+#include "memory_resource.hpp"
 #include "operations/operations.hpp"
+#include "roots.hpp"
+#include "sources.hpp"
+#include "tape.hpp"
 #include "uncertain.hpp"
 
 /** @file sigma.hpp
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+/** @file sources.hpp
+ *  @brief Controls how long the sources of uncertainty are kept
+ */
+
+namespace sigma {
+
+/** @brief Recycles the sources created on the calling thread for its
+ *         lifetime
+ *
+ *  Every variable constructed from a mean and a standard deviation is a new
+ *  source, recorded in a central registry. While the scope is alive, the
+ *  sources the calling thread creates are collected, and once it ends
+ *  their IDs are reused by the next ones created on that thread. A batch
+ *  loop then keeps the registry at the size of a single batch:
+ *
+ *  @code
+ *  for(const auto& batch : batches) {
+ *      sigma::ScopedSources<sigma::UDouble> sources;
+ *      // ... inputs, temporaries and results of the batch ...
+ *  }
+ *  @endcode
+ *
+ *  Variables depending on sources created in the scope must not be used
+ *  once it ends, just like variables allocated from an arena (see
+ *  ScopedMemoryResource). Copy out their means and standard deviations
+ *  first. Scopes may be nested, the innermost one collecting the sources.
+ *  Not available with a fixed set of sources, which are never registered.
+ *
+ *  @tparam UncertainType The type of the variables whose sources to recycle
+ */
+template<typename UncertainType>
+class ScopedSources {
+public:
+    /// Type of the registry the sources are recorded in
+    using registry_t = typename UncertainType::registry_t;
+
+    /// Type of the source IDs
+    using id_t = typename registry_t::id_t;
+
+    static_assert(!UncertainType::fixed_sources,
+                  "Sources in a fixed set are not registered");
+
+    /** @brief Start collecting the sources created on the calling thread
+     *
+     *  @throw none No throw guarantee
+     */
+    ScopedSources() noexcept :
+      m_previous_(registry_t::instance().record(&m_ids_)) {}
+
+    /// @brief Deleted copy ctor, the scope is tied to the calling thread
+    ScopedSources(const ScopedSources&) = delete;
+
+    /// @brief Deleted copy assignment, the scope is tied to the calling thread
+    ScopedSources& operator=(const ScopedSources&) = delete;
+
+    /** @brief Release the sources created in the scope for reuse
+     *
+     *  If storing the released IDs fails, they are simply not reused.
+     */
+    ~ScopedSources() noexcept {
+        auto& registry = registry_t::instance();
+        registry.record(m_previous_);
+        try {
+            registry.release(m_ids_);
+        } catch(...) {}
+    }
+
+    /** @brief The number of sources created in the scope so far
+     *
+     *  @throw none No throw guarantee
+     */
+    std::size_t size() const noexcept { return m_ids_.size(); }
+
+private:
+    /// The IDs of the sources created in the scope
+    std::vector<id_t> m_ids_;
+
+    /// Where the sources were collected before this scope
+    std::vector<id_t>* m_previous_;
+};
+
+} // namespace sigma
@@ -0,0 +1,1108 @@
+#pragma once
+#include "sigma/detail_/operation_common.hpp"
+#include "sigma/detail_/setter.hpp"
+#include "sigma/kernels.hpp"
+#include "sigma/memory_resource.hpp"
+#include "sigma/uncertain.hpp"
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** @file tape.hpp
+ *  @brief Reverse-mode propagation of uncertainty
+ *
+ *  Each operation on an Uncertain carries the full set of dependencies of
+ *  its result, which for long computations on many sources costs a lot of
+ *  memory and time in the intermediate values. On a Tape, the operations
+ *  instead only append a compact record of their partial derivatives, and
+ *  a single backward sweep per output then gives its sensitivity to all of
+ *  the inputs, from which the dependencies of the output are formed once.
+ *
+ *  A tape recorded for updates also keeps the operations themselves, so
+ *  that when the mean of an input changes only the records depending on it
+ *  are computed again.
+ */
+
+namespace sigma {
+
+template<typename UncertainType>
+class TapeVariable;
+
+namespace detail_::tape_ops {
+
+/// The sum of two values
+template<typename T>
+kernels::ValueGrad<T> add(T a, T b, T) {
+    return {a + b, 1, 1};
+}
+
+/// The difference of two values
+template<typename T>
+kernels::ValueGrad<T> subtract(T a, T b, T) {
+    return {a - b, 1, -1};
+}
+
+/// The product of two values
+template<typename T>
+kernels::ValueGrad<T> multiply(T a, T b, T) {
+    return {a * b, b, a};
+}
+
+/// The quotient of two values
+template<typename T>
+kernels::ValueGrad<T> divide(T a, T b, T) {
+    T value = a / b;
+    return {value, 1 / b, -value / b};
+}
+
+/// The sum of a value and a constant
+template<typename T>
+kernels::ValueGrad<T> add_constant(T a, T, T k) {
+    return {a + k, 1, 0};
+}
+
+/// The difference of a value and a constant
+template<typename T>
+kernels::ValueGrad<T> subtract_constant(T a, T, T k) {
+    return {a - k, 1, 0};
+}
+
+/// The difference of a constant and a value
+template<typename T>
+kernels::ValueGrad<T> subtract_from_constant(T a, T, T k) {
+    return {k - a, -1, 0};
+}
+
+/// The product of a value and a constant
+template<typename T>
+kernels::ValueGrad<T> multiply_constant(T a, T, T k) {
+    return {a * k, k, 0};
+}
+
+/// The quotient of a value and a constant
+template<typename T>
+kernels::ValueGrad<T> divide_constant(T a, T, T k) {
+    return {a / k, 1 / k, 0};
+}
+
+/// The quotient of a constant and a value
+template<typename T>
+kernels::ValueGrad<T> divide_constant_by(T a, T, T k) {
+    T value = k / a;
+    return {value, -value / a, 0};
+}
+
+/// The negation of a value
+template<typename T>
+kernels::ValueGrad<T> negate(T a, T, T) {
+    return {-a, -1, 0};
+}
+
+/// The absolute value of a value
+template<typename T>
+kernels::ValueGrad<T> abs(T a, T, T) {
+    return {std::abs(a), T((a >= 0) ? 1 : -1), 0};
+}
+
+/// A value to a constant power
+template<typename T>
+kernels::ValueGrad<T> pow_constant(T a, T, T k) {
+    return {std::pow(a, k), k * std::pow(a, k - 1), 0};
+}
+
+/// A value to the power of another
+template<typename T>
+kernels::ValueGrad<T> pow(T a, T b, T) {
+    T value = std::pow(a, b);
+    return {value, b * std::pow(a, b - 1), std::log(a) * value};
+}
+
+/// The arc tangent of the quotient of two values
+template<typename T>
+kernels::ValueGrad<T> atan2(T y, T x, T) {
+    T r2 = x * x + y * y;
+    return {std::atan2(y, x), x / r2, -y / r2};
+}
+
+/// The hypotenuse of two values
+template<typename T>
+kernels::ValueGrad<T> hypot(T a, T b, T) {
+    T h = std::hypot(a, b);
+    return {h, a / h, b / h};
+}
+
+/// A kernel applied to a value
+template<typename Kernel, typename T>
+kernels::ValueGrad<T> kernel(T a, T, T) {
+    auto [value, deriv] = Kernel{}(a);
+    return {value, deriv, 0};
+}
+
+} // namespace detail_::tape_ops
+
+/** @brief Records operations for reverse-mode propagation of uncertainty
+ *
+ *  Uncertain variables are put on the tape with variable(), computed with
+ *  as TapeVariable, and the results are turned back into Uncertain
+ *  variables with evaluate(). A tape is not thread safe, and variables on
+ *  it are only valid until it is cleared or destroyed.
+ *
+ *  A tape recorded for updates also keeps the operations, their constant
+ *  operands and their values. set_mean() then changes the mean of an input
+ *  and computes again only the records that depend on it, patching their
+ *  values and partial derivatives in place, after which changed() tells
+ *  which results have to be evaluated again.
+ *
+ *  @code
+ *  sigma::Tape<sigma::UDouble> tape;
+ *  auto x = tape.variable(a);
+ *  auto y = tape.variable(b);
+ *  sigma::UDouble z = tape.evaluate(x * sin(y) + 2.0 * x);
+ *  @endcode
+ *
+ *  @tparam UncertainType The type of the variables put on the tape
+ */
+template<typename UncertainType>
+class Tape {
+private:
+    /// Type of this instance
+    using my_t = Tape<UncertainType>;
+
+public:
+    /// Type of the inputs and outputs
+    using uncertain_t = UncertainType;
+
+    /// Numeric type
+    using value_t = typename uncertain_t::value_t;
+
+    /// Type of the variables on the tape
+    using variable_t = TapeVariable<uncertain_t>;
+
+    /// Type of the index of a record
+    using index_t = std::uint32_t;
+
+    /// Size type
+    using size_type = std::size_t;
+
+    /// An operation, with the partial derivatives of its result
+    struct record_t {
+        /// The indices of the operands, no_parent for unused ones
+        index_t parents[2];
+
+        /// The partial derivatives with respect to the operands
+        value_t partials[2];
+    };
+
+    /// Type of the list of inputs, with the indices of their records
+    using inputs_t = std::pmr::vector<std::pair<index_t, uncertain_t>>;
+
+    /// The value of an operation and its partial derivatives
+    using step_t = kernels::ValueGrad<value_t>;
+
+    /// Computes an operation from the values of its operands and a constant
+    using op_t = step_t (*)(value_t, value_t, value_t);
+
+    /** @brief Construct an empty tape
+     *
+     *  @throw none No throw guarantee
+     */
+    Tape() : Tape(false) {}
+
+    /** @brief Construct an empty tape, possibly recorded for updates
+     *
+     *  @param updatable Whether to keep the operations, so that the means of
+     *                   the inputs can be changed with set_mean()
+     *
+     *  @throw none No throw guarantee
+     */
+    explicit Tape(bool updatable) :
+      m_records_(sigma::get_memory_resource()),
+      m_inputs_(sigma::get_memory_resource()),
+      m_steps_(sigma::get_memory_resource()),
+      m_updatable_(updatable) {}
+
+    /// Variables refer to their tape, which must stay in place
+    Tape(const my_t&) = delete;
+
+    /// Variables refer to their tape, which must stay in place
+    my_t& operator=(const my_t&) = delete;
+
+    /** @brief Put a variable on the tape
+     *
+     *  @param x The variable. It is copied, which is cheap for the default
+     *           dependency storage, which shares its contents.
+     *
+     *  @return The variable on the tape
+     *
+     *  @throw std::overflow_error if the tape is full. Strong throw
+     *         guarantee.
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    variable_t variable(const uncertain_t& x) {
+        index_t index = push({no_parent, no_parent}, {x.mean(), 0, 0});
+        try {
+            m_inputs_.emplace_back(index, x);
+        } catch(...) {
+            m_records_.pop_back();
+            if(m_updatable_) m_steps_.pop_back();
+            throw;
+        }
+        return variable_t(this, index, x.mean());
+    }
+
+    /** @brief Propagate uncertainty to a result computed on the tape
+     *
+     *  Sweeps backwards over the records up to @p y, accumulating the
+     *  sensitivity of @p y to each of them, and combines the dependencies
+     *  of the inputs with a single merge. Several results may be evaluated
+     *  from the same tape, at the cost of one sweep each.
+     *
+     *  @param y The result, a variable on this tape
+     *
+     *  @return An Uncertain variable with the mean of @p y, depending on the
+     *          sources the inputs of @p y depend on
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    uncertain_t evaluate(const variable_t& y) const {
+        std::pmr::vector<value_t> adjoints(y.index() + 1, value_t{0},
+                                           sigma::get_memory_resource());
+        adjoints[y.index()] = value_t{1};
+        for(index_t i = y.index() + 1; i-- > 0;) {
+            value_t adjoint = adjoints[i];
+            if(adjoint == value_t{0}) continue;
+            const auto& record = m_records_[i];
+            for(std::size_t j = 0; j < 2; ++j) {
+                if(record.parents[j] == no_parent) break;
+                adjoints[record.parents[j]] += record.partials[j] * adjoint;
+            }
+        }
+
+        std::pmr::vector<detail_::operand_t<uncertain_t>> operands(
+          sigma::get_memory_resource());
+        for(const auto& [index, x] : m_inputs_) {
+            if(index > y.index()) break;
+            if(adjoints[index] != value_t{0}) {
+                operands.emplace_back(&x, adjoints[index]);
+            }
+        }
+        return detail_::nary_result(y.value(), operands);
+    }
+
+    /** @brief The number of records on the tape
+     *
+     *  @return The number of inputs and operations recorded
+     *
+     *  @throw none No throw guarantee
+     */
+    size_type size() const noexcept { return m_records_.size(); }
+
+    /** @brief Get a record
+     *
+     *  @param index The index of the record, less than size()
+     *
+     *  @return The record
+     *
+     *  @throw none No throw guarantee
+     */
+    const record_t& record(index_t index) const { return m_records_[index]; }
+
+    /** @brief Get the inputs
+     *
+     *  @return The inputs, in the order they were put on the tape, with the
+     *          indices of their records
+     *
+     *  @throw none No throw guarantee
+     */
+    const inputs_t& inputs() const noexcept { return m_inputs_; }
+
+    /** @brief Whether the tape is recorded for updates
+     *
+     *  @return Whether set_mean() may be used
+     *
+     *  @throw none No throw guarantee
+     */
+    bool updatable() const noexcept { return m_updatable_; }
+
+    /** @brief Get the current value of a record of a tape recorded for
+     *         updates
+     *
+     *  @param index The index of the record, less than size()
+     *
+     *  @return The value, after the last call to set_mean()
+     *
+     *  @throw none No throw guarantee
+     */
+    value_t value(index_t index) const { return m_steps_[index].value; }
+
+    /** @brief Change the mean of an input of a tape recorded for updates
+     *
+     *  Only the records depending on @p x are computed again, in order,
+     *  from the values of their operands, and their partial derivatives are
+     *  replaced. The variables recorded afterwards use the new values. The
+     *  Uncertain variable @p x was put on the tape from is not modified.
+     *
+     *  @param x An input of this tape, see variable()
+     *  @param mean The new mean of @p x
+     *
+     *  @throw std::logic_error if the tape is not recorded for updates.
+     *         Strong throw guarantee.
+     *  @throw std::invalid_argument if @p x is not an input of this tape.
+     *         Strong throw guarantee.
+     */
+    void set_mean(const variable_t& x, value_t mean) {
+        if(!m_updatable_) {
+            throw std::logic_error("The tape is not recorded for updates");
+        }
+        auto input = std::lower_bound(
+          m_inputs_.begin(), m_inputs_.end(), x.index(),
+          [](const auto& in, index_t index) { return in.first < index; });
+        if(input == m_inputs_.end() || input->first != x.index()) {
+            throw std::invalid_argument("Only inputs of the tape can be set");
+        }
+
+        ++m_generation_;
+        detail_::Setter<uncertain_t>(input->second).update_mean(mean);
+        m_steps_[x.index()].value      = mean;
+        m_steps_[x.index()].generation = m_generation_;
+        for(std::size_t i = x.index() + 1; i < m_records_.size(); ++i) {
+            auto& record = m_records_[i];
+            auto& step   = m_steps_[i];
+            if(!step.op) continue;
+            if(!changed_(record.parents[0]) && !changed_(record.parents[1])) {
+                continue;
+            }
+            value_t b = 0;
+            if(record.parents[1] != no_parent) {
+                b = m_steps_[record.parents[1]].value;
+            }
+            auto result = step.op(m_steps_[record.parents[0]].value, b,
+                                  step.constant);
+            record.partials[0] = result.lhs_deriv;
+            record.partials[1] = result.rhs_deriv;
+            step.value         = result.value;
+            step.generation    = m_generation_;
+        }
+    }
+
+    /** @brief Whether the last call to set_mean() changed a variable
+     *
+     *  @param y A variable on this tape, which is recorded for updates
+     *
+     *  @return Whether @p y depends on the input whose mean was last set,
+     *          and so needs to be evaluated again
+     *
+     *  @throw none No throw guarantee
+     */
+    bool changed(const variable_t& y) const noexcept {
+        return changed_(y.index());
+    }
+
+    /** @brief Remove all of the records, invalidating the variables on
+     *         the tape
+     *
+     *  @throw none No throw guarantee
+     */
+    void clear() noexcept {
+        m_records_.clear();
+        m_inputs_.clear();
+        m_steps_.clear();
+    }
+
+    /** @brief Record an operation
+     *
+     *  Used by the operations on TapeVariable.
+     *
+     *  @param parents The indices of the operands, no_parent for unused
+     *  @param step The value of the result and the partial derivatives with
+     *              respect to the operands
+     *  @param op The operation, kept if the tape is recorded for updates.
+     *            Null for an input.
+     *  @param constant The constant operand of @p op
+     *
+     *  @return The index of the new record
+     *
+     *  @throw std::overflow_error if the tape is full. Strong throw
+     *         guarantee.
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    index_t push(const index_t (&parents)[2], const step_t& step,
+                 op_t op = nullptr, value_t constant = 0) {
+        if(m_records_.size() >= no_parent) {
+            throw std::overflow_error("Too many records for the tape");
+        }
+        m_records_.push_back({{parents[0], parents[1]},
+                              {step.lhs_deriv, step.rhs_deriv}});
+        if(m_updatable_) {
+            try {
+                m_steps_.push_back({op, constant, step.value, 0});
+            } catch(...) {
+                m_records_.pop_back();
+                throw;
+            }
+        }
+        return static_cast<index_t>(m_records_.size() - 1);
+    }
+
+    /// Marks an unused operand of a record
+    static constexpr index_t no_parent = std::numeric_limits<index_t>::max();
+
+private:
+    /// What a tape recorded for updates keeps about each record
+    struct Step {
+        /// The operation, null for an input
+        op_t op;
+
+        /// The constant operand of the operation
+        value_t constant;
+
+        /// The current value
+        value_t value;
+
+        /// The last call to set_mean() that changed the value
+        std::uint64_t generation;
+    };
+
+    /// Whether the last call to set_mean() changed a record
+    bool changed_(index_t index) const noexcept {
+        return index != no_parent && m_updatable_ &&
+               m_steps_[index].generation == m_generation_ &&
+               m_generation_ != 0;
+    }
+
+    /// The recorded operations, in order
+    std::pmr::vector<record_t> m_records_;
+
+    /// The inputs, with the index of their records, in order
+    inputs_t m_inputs_;
+
+    /// The operations and values of the records, if recorded for updates
+    std::pmr::vector<Step> m_steps_;
+
+    /// The number of calls to set_mean()
+    std::uint64_t m_generation_ = 0;
+
+    /// Whether the operations are kept for updates
+    bool m_updatable_;
+};
+
+/** @brief A value computed on a Tape
+ *
+ *  Supports the arithmetic, comparisons and math functions of Uncertain,
+ *  each of which appends a record to the tape. Mixing variables from
+ *  different tapes is undefined.
+ *
+ *  @tparam UncertainType The type of the variables put on the tape
+ */
+template<typename UncertainType>
+class TapeVariable {
+private:
+    /// Type of this instance
+    using my_t = TapeVariable<UncertainType>;
+
+public:
+    /// Type of the tape
+    using tape_t = Tape<UncertainType>;
+
+    /// Numeric type
+    using value_t = typename tape_t::value_t;
+
+    /// Type of the index of a record
+    using index_t = typename tape_t::index_t;
+
+    /// Type of an operation
+    using op_t = typename tape_t::op_t;
+
+    /** @brief Construct a variable on a tape
+     *
+     *  @param tape The tape
+     *  @param index The index of the record of the variable
+     *  @param value The value of the variable
+     *
+     *  @throw none No throw guarantee
+     */
+    TapeVariable(tape_t* tape, index_t index, value_t value) :
+      m_tape_(tape), m_index_(index), m_value_(value) {}
+
+    /** @brief Get the value
+     *
+     *  @return The value, after the last call to Tape::set_mean() if the
+     *          tape is recorded for updates
+     *
+     *  @throw none No throw guarantee
+     */
+    value_t value() const {
+        return m_tape_->updatable() ? m_tape_->value(m_index_) : m_value_;
+    }
+
+    /** @brief Get the index of the record of the variable
+     *
+     *  @return The index
+     *
+     *  @throw none No throw guarantee
+     */
+    index_t index() const { return m_index_; }
+
+    /** @brief Get the tape
+     *
+     *  @return The tape the variable is on
+     *
+     *  @throw none No throw guarantee
+     */
+    tape_t* tape() const { return m_tape_; }
+
+    /** @brief Record an operation on this variable
+     *
+     *  @param op The operation, see detail_::tape_ops
+     *  @param constant The constant operand of @p op, if it has one
+     *
+     *  @return The result
+     *
+     *  @throw std::overflow_error if the tape is full. Strong throw
+     *         guarantee.
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t apply(op_t op, value_t constant = 0) const {
+        auto step     = op(value(), 0, constant);
+        index_t index = m_tape_->push({m_index_, tape_t::no_parent}, step, op,
+                                      constant);
+        return my_t(m_tape_, index, step.value);
+    }
+
+    /** @brief Record an operation on this variable and another
+     *
+     *  @param op The operation, see detail_::tape_ops
+     *  @param b The other variable
+     *  @param constant The constant operand of @p op, if it has one
+     *
+     *  @return The result
+     *
+     *  @throw std::overflow_error if the tape is full. Strong throw
+     *         guarantee.
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t apply(op_t op, const my_t& b, value_t constant = 0) const {
+        auto step     = op(value(), b.value(), constant);
+        index_t index = m_tape_->push({m_index_, b.m_index_}, step, op,
+                                      constant);
+        return my_t(m_tape_, index, step.value);
+    }
+
+    /** @brief Add another variable to this one
+     *
+     *  @param rhs The variable to add
+     *
+     *  @return This instance, after the addition
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator+=(const my_t& rhs) {
+        return *this = apply(detail_::tape_ops::add<value_t>, rhs);
+    }
+
+    /** @brief Subtract another variable from this one
+     *
+     *  @param rhs The variable to subtract
+     *
+     *  @return This instance, after the subtraction
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator-=(const my_t& rhs) {
+        return *this = apply(detail_::tape_ops::subtract<value_t>, rhs);
+    }
+
+    /** @brief Multiply this variable by another one
+     *
+     *  @param rhs The variable to multiply by
+     *
+     *  @return This instance, after the multiplication
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator*=(const my_t& rhs) {
+        return *this = apply(detail_::tape_ops::multiply<value_t>, rhs);
+    }
+
+    /** @brief Divide this variable by another one
+     *
+     *  @param rhs The variable to divide by
+     *
+     *  @return This instance, after the division
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator/=(const my_t& rhs) {
+        return *this = apply(detail_::tape_ops::divide<value_t>, rhs);
+    }
+
+    /** @brief Add a number to this variable
+     *
+     *  @param rhs The number to add
+     *
+     *  @return This instance, after the addition
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator+=(value_t rhs) {
+        return *this = apply(detail_::tape_ops::add_constant<value_t>, rhs);
+    }
+
+    /** @brief Subtract a number from this variable
+     *
+     *  @param rhs The number to subtract
+     *
+     *  @return This instance, after the subtraction
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator-=(value_t rhs) {
+        return *this =
+                 apply(detail_::tape_ops::subtract_constant<value_t>, rhs);
+    }
+
+    /** @brief Multiply this variable by a number
+     *
+     *  @param rhs The number to multiply by
+     *
+     *  @return This instance, after the multiplication
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator*=(value_t rhs) {
+        return *this =
+                 apply(detail_::tape_ops::multiply_constant<value_t>, rhs);
+    }
+
+    /** @brief Divide this variable by a number
+     *
+     *  @param rhs The number to divide by
+     *
+     *  @return This instance, after the division
+     *
+     *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+     */
+    my_t& operator/=(value_t rhs) {
+        return *this = apply(detail_::tape_ops::divide_constant<value_t>, rhs);
+    }
+
+private:
+    /// The tape
+    tape_t* m_tape_;
+
+    /// The index of the record of the variable
+    index_t m_index_;
+
+    /// The value
+    value_t m_value_;
+};
+
+namespace detail_ {
+
+/** @brief Whether a type is a TapeVariable
+ *
+ *  @tparam T The type to check
+ */
+template<typename T>
+struct is_tape_variable : std::false_type {};
+
+/// @brief Specialization for TapeVariable
+template<typename U>
+struct is_tape_variable<TapeVariable<U>> : std::true_type {};
+
+/** @brief Enables the operations between a tape variable and another or a
+ *         plain number
+ *
+ *  @tparam L The type of the left operand
+ *  @tparam R The type of the right operand
+ */
+template<typename L, typename R>
+using enable_if_tape_operands_t = std::enable_if_t<
+  (is_tape_variable<L>::value &&
+   (is_tape_variable<R>::value || std::is_arithmetic_v<R>)) ||
+    (std::is_arithmetic_v<L> && is_tape_variable<R>::value),
+  int>;
+
+/** @brief The value of an operand that may be a plain number
+ *
+ *  @tparam T The type of the operand
+ *  @param x The operand
+ *
+ *  @return The value of @p x if it is a TapeVariable, @p x itself otherwise
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename T>
+auto tape_value(const T& x) {
+    if constexpr(is_tape_variable<T>::value) {
+        return x.value();
+    } else {
+        return x;
+    }
+}
+
+/** @brief Apply a kernel to a tape variable
+ *
+ *  @tparam Kernel The type of the kernel
+ *  @tparam U The type of the variables put on the tape
+ *  @param kernel The kernel, see sigma::kernels
+ *  @param x The argument
+ *
+ *  @return The function of @p x
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename Kernel, typename U>
+TapeVariable<U> tape_kernel(Kernel, const TapeVariable<U>& x) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return x.apply(tape_ops::kernel<Kernel, value_t>);
+}
+
+} // namespace detail_
+
+// -- Arithmetic ---------------------------------------------------------------
+
+/// @brief Identity of a tape variable
+template<typename U>
+TapeVariable<U> operator+(const TapeVariable<U>& a) {
+    return a;
+}
+
+/// @brief Negation of a tape variable
+template<typename U>
+TapeVariable<U> operator-(const TapeVariable<U>& a) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return a.apply(detail_::tape_ops::negate<value_t>);
+}
+
+/** @brief Sum of two operands, at least one of them a tape variable
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The sum of @p a and @p b
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+auto operator+(const L& a, const R& b) {
+    if constexpr(!detail_::is_tape_variable<L>::value) {
+        return b + a;
+    } else {
+        L c(a);
+        return c += b;
+    }
+}
+
+/** @brief Difference of two operands, at least one of them a tape variable
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The difference of @p a and @p b
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+auto operator-(const L& a, const R& b) {
+    if constexpr(!detail_::is_tape_variable<L>::value) {
+        using value_t = typename R::value_t;
+        return b.apply(detail_::tape_ops::subtract_from_constant<value_t>, a);
+    } else {
+        L c(a);
+        return c -= b;
+    }
+}
+
+/** @brief Product of two operands, at least one of them a tape variable
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The product of @p a and @p b
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+auto operator*(const L& a, const R& b) {
+    if constexpr(!detail_::is_tape_variable<L>::value) {
+        return b * a;
+    } else {
+        L c(a);
+        return c *= b;
+    }
+}
+
+/** @brief Quotient of two operands, at least one of them a tape variable
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return The quotient of @p a and @p b
+ *
+ *  @throw std::bad_alloc if an allocation fails. Strong throw guarantee.
+ */
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+auto operator/(const L& a, const R& b) {
+    if constexpr(!detail_::is_tape_variable<L>::value) {
+        using value_t = typename R::value_t;
+        return b.apply(detail_::tape_ops::divide_constant_by<value_t>, a);
+    } else {
+        L c(a);
+        return c /= b;
+    }
+}
+
+// -- Comparisons --------------------------------------------------------------
+
+/** @brief Compare the values of two operands, at least one of them a tape
+ *         variable
+ *
+ *  @param a The left operand
+ *  @param b The right operand
+ *
+ *  @return Whether the value of @p a is less than that of @p b
+ *
+ *  @throw none No throw guarantee
+ */
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+bool operator<(const L& a, const R& b) {
+    return detail_::tape_value(a) < detail_::tape_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+bool operator>(const L& a, const R& b) {
+    return detail_::tape_value(a) > detail_::tape_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+bool operator<=(const L& a, const R& b) {
+    return detail_::tape_value(a) <= detail_::tape_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+bool operator>=(const L& a, const R& b) {
+    return detail_::tape_value(a) >= detail_::tape_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+bool operator==(const L& a, const R& b) {
+    return detail_::tape_value(a) == detail_::tape_value(b);
+}
+
+/// @overload
+template<typename L, typename R,
+         detail_::enable_if_tape_operands_t<L, R> = 0>
+bool operator!=(const L& a, const R& b) {
+    return detail_::tape_value(a) != detail_::tape_value(b);
+}
+
+// -- Functions ----------------------------------------------------------------
+
+/// @brief Absolute value of a tape variable
+template<typename U>
+TapeVariable<U> abs(const TapeVariable<U>& a) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return a.apply(detail_::tape_ops::abs<value_t>);
+}
+
+/// @brief Power of a tape variable, with a plain exponent
+template<typename U, typename E,
+         typename = std::enable_if_t<std::is_arithmetic_v<E>>>
+TapeVariable<U> pow(const TapeVariable<U>& a, E exp) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return a.apply(detail_::tape_ops::pow_constant<value_t>, exp);
+}
+
+/// @brief Power of two tape variables
+template<typename U>
+TapeVariable<U> pow(const TapeVariable<U>& a, const TapeVariable<U>& exp) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return a.apply(detail_::tape_ops::pow<value_t>, exp);
+}
+
+/// @brief Arc tangent of the quotient of two tape variables
+template<typename U>
+TapeVariable<U> atan2(const TapeVariable<U>& y, const TapeVariable<U>& x) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return y.apply(detail_::tape_ops::atan2<value_t>, x);
+}
+
+/// @brief Hypotenuse of two tape variables
+template<typename U>
+TapeVariable<U> hypot(const TapeVariable<U>& a, const TapeVariable<U>& b) {
+    using value_t = typename TapeVariable<U>::value_t;
+    return a.apply(detail_::tape_ops::hypot<value_t>, b);
+}
+
+/// @brief Sine of a tape variable
+template<typename U>
+TapeVariable<U> sin(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Sin{}, a);
+}
+
+/// @brief Cosine of a tape variable
+template<typename U>
+TapeVariable<U> cos(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Cos{}, a);
+}
+
+/// @brief Tangent of a tape variable
+template<typename U>
+TapeVariable<U> tan(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Tan{}, a);
+}
+
+/// @brief Arc sine of a tape variable
+template<typename U>
+TapeVariable<U> asin(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Asin{}, a);
+}
+
+/// @brief Arc cosine of a tape variable
+template<typename U>
+TapeVariable<U> acos(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Acos{}, a);
+}
+
+/// @brief Arc tangent of a tape variable
+template<typename U>
+TapeVariable<U> atan(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Atan{}, a);
+}
+
+/// @brief Hyperbolic sine of a tape variable
+template<typename U>
+TapeVariable<U> sinh(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Sinh{}, a);
+}
+
+/// @brief Hyperbolic cosine of a tape variable
+template<typename U>
+TapeVariable<U> cosh(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Cosh{}, a);
+}
+
+/// @brief Hyperbolic tangent of a tape variable
+template<typename U>
+TapeVariable<U> tanh(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Tanh{}, a);
+}
+
+/// @brief Inverse hyperbolic sine of a tape variable
+template<typename U>
+TapeVariable<U> asinh(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Asinh{}, a);
+}
+
+/// @brief Inverse hyperbolic cosine of a tape variable
+template<typename U>
+TapeVariable<U> acosh(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Acosh{}, a);
+}
+
+/// @brief Inverse hyperbolic tangent of a tape variable
+template<typename U>
+TapeVariable<U> atanh(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Atanh{}, a);
+}
+
+/// @brief Square root of a tape variable
+template<typename U>
+TapeVariable<U> sqrt(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Sqrt{}, a);
+}
+
+/// @brief Cube root of a tape variable
+template<typename U>
+TapeVariable<U> cbrt(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Cbrt{}, a);
+}
+
+/// @brief Exponential of a tape variable
+template<typename U>
+TapeVariable<U> exp(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Exp{}, a);
+}
+
+/// @brief Base 2 exponential of a tape variable
+template<typename U>
+TapeVariable<U> exp2(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Exp2{}, a);
+}
+
+/// @brief Exponential minus one of a tape variable
+template<typename U>
+TapeVariable<U> expm1(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Expm1{}, a);
+}
+
+/// @brief Natural logarithm of a tape variable
+template<typename U>
+TapeVariable<U> log(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Log{}, a);
+}
+
+/// @brief Base 10 logarithm of a tape variable
+template<typename U>
+TapeVariable<U> log10(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Log10{}, a);
+}
+
+/// @brief Base 2 logarithm of a tape variable
+template<typename U>
+TapeVariable<U> log2(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Log2{}, a);
+}
+
+/// @brief Natural logarithm of one plus a tape variable
+template<typename U>
+TapeVariable<U> log1p(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Log1p{}, a);
+}
+
+/// @brief Error function of a tape variable
+template<typename U>
+TapeVariable<U> erf(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Erf{}, a);
+}
+
+/// @brief Complementary error function of a tape variable
+template<typename U>
+TapeVariable<U> erfc(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Erfc{}, a);
+}
+
+/// @brief Gamma function of a tape variable
+template<typename U>
+TapeVariable<U> tgamma(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Tgamma{}, a);
+}
+
+/// @brief Natural logarithm of the gamma function of a tape variable
+template<typename U>
+TapeVariable<U> lgamma(const TapeVariable<U>& a) {
+    return detail_::tape_kernel(kernels::Lgamma{}, a);
+}
+
+} // namespace sigma
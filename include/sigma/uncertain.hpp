@@ -1,8 +1,15 @@
 #pragma once
+#include "sigma/detail_/adaptive_deps.hpp"
+#include "sigma/detail_/cached_value.hpp"
+#include "sigma/detail_/deps_map.hpp"
+#include "sigma/detail_/fixed_deps.hpp"
+#include "sigma/detail_/hash_deps.hpp"
+#include "sigma/detail_/source_registry.hpp"
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
-#include <map>
-#include <memory>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 
@@ -24,16 +31,27 @@ class Setter; // Class to alter values inside Uncertain
  *  more independent variables. It has a mean value and standard deviation. This
  *  class also keeps track of the variables that each instance is dependent
  *  upon and the contribution of that variable to the uncertainty of this
- *  instance.
+ *  instance. The standard deviation is computed from those contributions
+ *  the first time it is requested after they change.
+ *
+ *  By default the dependencies are keyed by the IDs of the sources in the
+ *  central SourceRegistry. Alternatively, a detail_::FixedDeps storage can be
+ *  used for models with a fixed set of sources (see FixedUncertain), or a
+ *  detail_::AdaptiveDeps storage for values that may depend on most of the
+ *  sources (see AdaptiveUncertain), or a detail_::HashDeps storage for
+ *  values depending on very many sources (see HashedUncertain).
  *
  *  @tparam ValueType The type of the value and standard deviation
+ *  @tparam DepsType The type storing the dependencies
  *
  */
-template<typename ValueType>
+template<typename ValueType,
+         typename DepsType = detail_::DepsMap<
+           typename detail_::SourceRegistry<ValueType>::id_t, ValueType>>
 class Uncertain {
 public:
     /// Type of the instance
-    using my_t = Uncertain<ValueType>;
+    using my_t = Uncertain<ValueType, DepsType>;
 
     /// The numeric type of the variable
     using value_t = ValueType;
@@ -41,11 +59,20 @@ public:
     /// The type of a standard deviation this depends on
     using dep_sd_t = value_t;
 
-    /// A pointer to a dependency of this variable
-    using dep_sd_ptr = std::shared_ptr<dep_sd_t>;
-
     /// A map of dependencies and their contributions to the uncertainty
-    using deps_map_t = std::map<dep_sd_ptr, value_t>;
+    using deps_map_t = DepsType;
+
+    /// The ID of a dependency of this variable
+    using dep_id_t = typename deps_map_t::key_type;
+
+    /// The registry holding the standard deviations of the dependencies
+    using registry_t = detail_::SourceRegistry<dep_sd_t, dep_id_t>;
+
+    /// The type the variance is accumulated in, at least double precision
+    using variance_t = std::common_type_t<value_t, double>;
+
+    /// Whether the dependencies are on a fixed set of standardized sources
+    static constexpr bool fixed_sources = detail_::is_fixed_deps_v<deps_map_t>;
 
     /// @brief Default ctor
     Uncertain() noexcept = default;
@@ -59,20 +86,37 @@ public:
      *
      *  @throw none No throw guarantee
      */
-    Uncertain(value_t mean) : m_mean_(mean), m_sd_(0.0) {}
+    Uncertain(value_t mean) : m_mean_(mean), m_sd_(0.0, sd_stamp_()) {}
 
     /** @brief Construct an uncertain value from mean and standard deviation
      *
      *  Effectively, this creates a value that is a function of a single
-     *  independent variable.
+     *  independent variable. Not available with a fixed set of sources,
+     *  whose variables need to be given their source explicitly.
      *
      *  @param mean The average value of the variable
      *  @param sd The standard deviation of the variable
      *
-     *  @throw none No throw guarantee
+     *  @throw std::overflow_error if every ID of the dependency ID type is
+     *         taken by a live source. Strong throw guarantee.
      */
     Uncertain(value_t mean, value_t sd);
 
+    /** @brief Construct an independent variable from one of a fixed set of
+     *         sources
+     *
+     *  Only available with a fixed set of sources. Variables constructed
+     *  from the same @p source are fully correlated.
+     *
+     *  @param mean The average value of the variable
+     *  @param sd The standard deviation of the variable
+     *  @param source The slot of the source of uncertainty of the variable
+     *
+     *  @throw std::out_of_range if @p source is not one of the slots of the
+     *         fixed set. Strong throw guarantee.
+     */
+    Uncertain(value_t mean, value_t sd, dep_id_t source);
+
     /** @brief Get the mean value of the variable
      *
      *  @return The value of the mean
@@ -82,12 +126,19 @@ public:
     value_t mean() const { return m_mean_; }
 
     /** @brief Get the standard deviation of the variable
+     *
+     *  The value is cached, so only the first call after the dependencies,
+     *  or the standard deviations of the sources (see set_source_sd()),
+     *  change has to go over them.
      *
      *  @return The value of the standard deviation
      *
      *  @throw none No throw guarantee
      */
-    value_t sd() const { return m_sd_; }
+    value_t sd() const {
+        return m_sd_.get_or_compute([this]() { return compute_sd_(); },
+                                    sd_stamp_());
+    }
 
     /** @brief Get the dependencies of the variable
      *
@@ -97,12 +148,43 @@ public:
      */
     const deps_map_t& deps() const { return m_deps_; }
 
+    /** @brief Get the standard deviation of a dependency
+     *
+     *  With a fixed set of sources the derivatives are with respect to the
+     *  standardized sources, so this is always one.
+     *
+     *  @param dep The ID of the dependency, i.e. a key of deps()
+     *
+     *  @return The standard deviation of the independent variable @p dep
+     *
+     *  @throw none No throw guarantee
+     */
+    static dep_sd_t dep_sd(dep_id_t dep) {
+        if constexpr(fixed_sources) {
+            return dep_sd_t{1.0};
+        } else {
+            return registry_t::instance().sd(dep);
+        }
+    }
+
 private:
+    /// Compute the standard deviation from the dependencies
+    value_t compute_sd_() const;
+
+    /// The stamp of a standard deviation computed now
+    static typename detail_::CachedValue<value_t>::stamp_t sd_stamp_() {
+        if constexpr(fixed_sources) {
+            return detail_::CachedValue<value_t>::default_stamp;
+        } else {
+            return registry_t::instance().generation();
+        }
+    }
+
     /// Mean value of the variable
-    value_t m_mean_;
+    value_t m_mean_ = 0.0;
 
-    /// Standard deviation of the variable
-    value_t m_sd_;
+    /// Cached standard deviation of the variable
+    detail_::CachedValue<value_t> m_sd_;
 
     /** Map of the standard deviations this value is dependent on to their
      *  partial derivatives with respect to this value
@@ -119,11 +201,40 @@ private:
 
 // -- Out-of-line Definitions --------------------------------------------------
 
-template<typename ValueType>
-Uncertain<ValueType>::Uncertain(value_t mean, value_t sd) :
-  m_mean_(mean), m_sd_(std::abs(sd)) {
-    m_deps_.emplace(
-      std::make_pair(std::make_shared<dep_sd_t>(sd), value_t{1.0}));
+template<typename ValueType, typename DepsType>
+Uncertain<ValueType, DepsType>::Uncertain(value_t mean, value_t sd) :
+  m_mean_(mean), m_sd_(std::abs(sd), sd_stamp_()) {
+    static_assert(!fixed_sources,
+                  "Variables with a fixed set of sources must name theirs");
+    m_deps_ = deps_map_t(registry_t::instance().add(sd), value_t{1.0});
+}
+
+template<typename ValueType, typename DepsType>
+Uncertain<ValueType, DepsType>::Uncertain(value_t mean, value_t sd,
+                                          dep_id_t source) :
+  m_mean_(mean), m_sd_(std::abs(sd)), m_deps_(source, sd) {
+    static_assert(fixed_sources,
+                  "Only variables with a fixed set of sources name theirs");
+}
+
+template<typename ValueType, typename DepsType>
+typename Uncertain<ValueType, DepsType>::value_t
+Uncertain<ValueType, DepsType>::compute_sd_() const {
+    variance_t variance = 0.0;
+    if constexpr(fixed_sources) {
+        for(const auto& deriv : m_deps_.gradient()) {
+            auto contribution = static_cast<variance_t>(deriv);
+            variance += contribution * contribution;
+        }
+    } else {
+        const auto& registry = registry_t::instance();
+        for(const auto& [dep, deriv] : m_deps_) {
+            auto contribution = static_cast<variance_t>(registry.sd(dep)) *
+                                static_cast<variance_t>(deriv);
+            variance += contribution * contribution;
+        }
+    }
+    return static_cast<value_t>(std::sqrt(variance));
 }
 
 // -- Utility functions --------------------------------------------------------
@@ -132,6 +243,7 @@ Uncertain<ValueType>::Uncertain(value_t mean, value_t sd) :
  *  @brief Overload stream insertion to print uncertain variable
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param os The ostream to write to
  *  @param u The uncertain variable to write
  *
@@ -140,8 +252,9 @@ Uncertain<ValueType>::Uncertain(value_t mean, value_t sd) :
  *  @throws std::ios_base::failure if anything goes wrong while writing.
  *          Weak throw guarantee.
  */
-template<typename ValueType>
-std::ostream& operator<<(std::ostream& os, const Uncertain<ValueType>& u) {
+template<typename ValueType, typename DepsType>
+std::ostream& operator<<(std::ostream& os,
+                         const Uncertain<ValueType, DepsType>& u) {
     os << u.mean() << "+/-" << u.sd();
     return os;
 }
@@ -150,16 +263,19 @@ std::ostream& operator<<(std::ostream& os, const Uncertain<ValueType>& u) {
  *  @brief Compare two variables for equality
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether the instances are equivalent
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator==(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
-    if constexpr(!std::is_same_v<ValueType1, ValueType2>) {
+template<typename ValueType1, typename DepsType1, typename ValueType2,
+         typename DepsType2>
+bool operator==(const Uncertain<ValueType1, DepsType1>& lhs,
+                const Uncertain<ValueType2, DepsType2>& rhs) {
+    if constexpr(!std::is_same_v<ValueType1, ValueType2> ||
+                 !std::is_same_v<DepsType1, DepsType2>) {
         return false;
     } else {
         if(lhs.mean() != rhs.mean()) return false;
@@ -173,15 +289,17 @@ bool operator==(const Uncertain<ValueType1>& lhs,
  *  @brief Compare two variables for inequality
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether the instances are not equivalent
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator!=(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename DepsType1, typename ValueType2,
+         typename DepsType2>
+bool operator!=(const Uncertain<ValueType1, DepsType1>& lhs,
+                const Uncertain<ValueType2, DepsType2>& rhs) {
     return !(lhs == rhs);
 }
 
@@ -191,15 +309,17 @@ bool operator!=(const Uncertain<ValueType1>& lhs,
  *  Compares the mean values of the two variables
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is less than @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator<(const Uncertain<ValueType1>& lhs,
-               const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename DepsType1, typename ValueType2,
+         typename DepsType2>
+bool operator<(const Uncertain<ValueType1, DepsType1>& lhs,
+               const Uncertain<ValueType2, DepsType2>& rhs) {
     return lhs.mean() < rhs.mean();
 }
 
@@ -209,15 +329,17 @@ bool operator<(const Uncertain<ValueType1>& lhs,
  *  Compares the mean values of the two variables
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is greater than @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator>(const Uncertain<ValueType1>& lhs,
-               const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename DepsType1, typename ValueType2,
+         typename DepsType2>
+bool operator>(const Uncertain<ValueType1, DepsType1>& lhs,
+               const Uncertain<ValueType2, DepsType2>& rhs) {
     return rhs < lhs;
 }
 
@@ -225,15 +347,17 @@ bool operator>(const Uncertain<ValueType1>& lhs,
  *  @brief Whether one variable is less than or equal to another
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is less than or equal to @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator<=(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename DepsType1, typename ValueType2,
+         typename DepsType2>
+bool operator<=(const Uncertain<ValueType1, DepsType1>& lhs,
+                const Uncertain<ValueType2, DepsType2>& rhs) {
     return (lhs == rhs) || (lhs < rhs);
 }
 
@@ -241,22 +365,119 @@ bool operator<=(const Uncertain<ValueType1>& lhs,
  *  @brief Whether one variable is greater than or equal to another
  *
  *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
  *  @param lhs The first variable
  *  @param rhs The second variable
  *
  *  @return Whether @p lhs is greater than or equal to @p rhs
  *
  */
-template<typename ValueType1, typename ValueType2>
-bool operator>=(const Uncertain<ValueType1>& lhs,
-                const Uncertain<ValueType2>& rhs) {
+template<typename ValueType1, typename DepsType1, typename ValueType2,
+         typename DepsType2>
+bool operator>=(const Uncertain<ValueType1, DepsType1>& lhs,
+                const Uncertain<ValueType2, DepsType2>& rhs) {
     return (lhs == rhs) || (lhs > rhs);
 }
 
+/** @relates Uncertain
+ *  @brief Change the standard deviation of an independent variable
+ *
+ *  Every variable computed from @p x, and @p x itself, sees the new
+ *  standard deviation the next time its own is requested, without
+ *  computing it again: only their standard deviations are recomputed,
+ *  from the derivatives they already hold. Copies of @p x made before
+ *  the call are the same source, and change as well. Must not be called
+ *  while other threads use variables depending on @p x.
+ *
+ *  Not available with a fixed set of sources, whose derivatives already
+ *  include the standard deviations of the sources.
+ *
+ *  @tparam ValueType The numerical type of the variable
+ *  @tparam DepsType The dependency storage type of the variable
+ *  @param x An independent variable, constructed from a mean and a
+ *           standard deviation
+ *  @param sd The new standard deviation of @p x
+ *
+ *  @throw std::invalid_argument if @p x is not an independent variable.
+ *         Strong throw guarantee.
+ */
+template<typename ValueType, typename DepsType>
+void set_source_sd(const Uncertain<ValueType, DepsType>& x, ValueType sd) {
+    using uncertain_t = Uncertain<ValueType, DepsType>;
+    static_assert(!uncertain_t::fixed_sources,
+                  "Sources in a fixed set are standardized");
+    const auto& deps = x.deps();
+    if(deps.size() != 1 || (*deps.begin()).second != ValueType{1}) {
+        throw std::invalid_argument("Only independent variables are sources");
+    }
+    uncertain_t::registry_t::instance().set_sd((*deps.begin()).first, sd);
+}
+
 /// Typedef for an uncertain float
 using UFloat = Uncertain<float>;
 
 /// Typedef for an uncertain double
 using UDouble = Uncertain<double>;
 
+/** @brief Uncertain variable depending on a fixed set of sources
+ *
+ *  The dependencies are a dense gradient over the @p N sources, stored
+ *  without allocating. Independent variables are created with
+ *  Uncertain(mean, sd, source), where `source < N`.
+ *
+ *  @tparam ValueType The type of the value and standard deviation
+ *  @tparam N The number of sources
+ */
+template<typename ValueType, std::size_t N>
+using FixedUncertain = Uncertain<ValueType, detail_::FixedDeps<ValueType, N>>;
+
+/** @brief Uncertain variable whose dependencies become dense as they fill up
+ *
+ *  The dependencies start out sparse and move to a dense array indexed by
+ *  source ID once they cover most of the sources in their range, and back
+ *  if cancellations empty it again. Suited to long computations whose later
+ *  values depend on most of the sources.
+ *
+ *  @tparam ValueType The type of the value and standard deviation
+ */
+template<typename ValueType>
+using AdaptiveUncertain = Uncertain<
+  ValueType,
+  detail_::AdaptiveDeps<typename detail_::SourceRegistry<ValueType>::id_t,
+                        ValueType>>;
+
+/** @brief Uncertain variable suited to very many dependencies
+ *
+ *  Once a value depends on enough sources, its dependencies move to a hash
+ *  table, so accumulating into it costs a constant time per added
+ *  dependency rather than a merge over all of its dependencies. Suited to
+ *  wide reductions, such as sums over large sets of measurements.
+ *
+ *  @tparam ValueType The type of the value and standard deviation
+ */
+template<typename ValueType>
+using HashedUncertain = Uncertain<
+  ValueType,
+  detail_::HashDeps<typename detail_::SourceRegistry<ValueType>::id_t,
+                    ValueType>>;
+
+/** @brief Uncertain variable storing its derivatives in reduced precision
+ *
+ *  The derivatives are stored as @p DerivativeType, float by default, next
+ *  to 32-bit source IDs, which halves the memory taken by the dependencies
+ *  of an Uncertain<double>. The mean stays in full precision and the
+ *  variance is still accumulated in at least double precision. Each stored
+ *  derivative carries a relative rounding error of about 6e-8 for float,
+ *  which adds up over the chain of operations producing a value. The 32-bit
+ *  IDs have their own registry, so only sources of compact variables count
+ *  against the 2^32 available, and those released by a ScopedSources are
+ *  reused.
+ *
+ *  @tparam ValueType The type of the value and standard deviation
+ *  @tparam DerivativeType The type the derivatives are stored as
+ */
+template<typename ValueType, typename DerivativeType = float>
+using CompactUncertain =
+  Uncertain<ValueType, detail_::DepsMap<std::uint32_t, DerivativeType>>;
+
 } // namespace sigma
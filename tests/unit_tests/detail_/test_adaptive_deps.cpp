@@ -0,0 +1,99 @@
+#include "../testing.hpp"
+#include <sigma/detail_/adaptive_deps.hpp>
+
+TEMPLATE_TEST_CASE("AdaptiveDeps", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::detail_::AdaptiveDeps<int, value_t>;
+
+    auto n = static_cast<int>(testing_t::min_dense_size) + 8;
+    auto range = [](int first, int last, value_t deriv) {
+        testing_t deps;
+        for(int i = first; i < last; ++i) deps.merge(testing_t(i, deriv), 1.0);
+        return deps;
+    };
+
+    testing_t dense = range(0, n, 1.0);
+
+    SECTION("Starts out sparse") {
+        testing_t a(1, 2.0);
+        REQUIRE_FALSE(a.is_dense());
+        REQUIRE(a.size() == 1);
+        REQUIRE(a.find(1)->second == 2.0);
+    }
+    SECTION("Goes dense once filled") {
+        REQUIRE(dense.is_dense());
+        REQUIRE(dense.size() == static_cast<std::size_t>(n));
+        REQUIRE(dense.find(5)->second == 1.0);
+        REQUIRE(dense.count(n) == 0);
+        int expected = 0;
+        for(const auto& [key, deriv] : dense) REQUIRE(key == expected++);
+        REQUIRE(expected == n);
+    }
+    SECTION("Stays sparse if spread out") {
+        testing_t spread;
+        for(int i = 0; i < n; ++i) spread.merge(testing_t(4 * i, 1.0), 1.0);
+        REQUIRE_FALSE(spread.is_dense());
+    }
+    SECTION("Scale") {
+        dense.scale(2.0);
+        REQUIRE(dense.find(3)->second == 2.0);
+        dense.scale(0.0);
+        REQUIRE(dense.empty());
+        REQUIRE_FALSE(dense.is_dense());
+    }
+    SECTION("Dense with sparse") {
+        dense.merge(testing_t(n + 10, 3.0), 2.0);
+        REQUIRE(dense.is_dense());
+        REQUIRE(dense.find(n + 10)->second == 6.0);
+        REQUIRE(dense.count(n + 5) == 0);
+        REQUIRE(dense.size() == static_cast<std::size_t>(n + 1));
+    }
+    SECTION("Sparse with dense") {
+        testing_t a(1, 2.0);
+        a.merge(dense, 3.0);
+        REQUIRE(a.is_dense());
+        REQUIRE(a.find(1)->second == 5.0);
+        REQUIRE(a.find(2)->second == 3.0);
+    }
+    SECTION("Dense with a distant key") {
+        const int far = 400000000;
+        testing_t a(far, 2.0);
+        a.merge(dense, 1.0);
+        REQUIRE_FALSE(a.is_dense());
+        REQUIRE(a.size() == static_cast<std::size_t>(n + 1));
+        REQUIRE(a.find(far)->second == 2.0);
+        dense.merge(testing_t(far, 2.0), 1.0);
+        REQUIRE_FALSE(dense.is_dense());
+        REQUIRE(dense == a);
+    }
+    SECTION("Dense with dense") {
+        auto shifted = range(n / 2, n + n / 2, 1.0);
+        shifted.scale(2.0);
+        dense.merge(shifted, 1.0);
+        REQUIRE(dense.find(0)->second == 1.0);
+        REQUIRE(dense.find(n - 1)->second == 3.0);
+        REQUIRE(dense.find(n)->second == 2.0);
+    }
+    SECTION("With itself") {
+        dense.merge(dense, 1.0);
+        REQUIRE(dense.find(0)->second == 2.0);
+    }
+    SECTION("Copies share storage until modified") {
+        testing_t copy(dense);
+        copy.merge(testing_t(0, 1.0), 1.0);
+        REQUIRE(copy.find(0)->second == 2.0);
+        REQUIRE(dense.find(0)->second == 1.0);
+    }
+    SECTION("Goes sparse once emptied") {
+        dense.merge(range(0, n - 4, 1.0), -1.0);
+        REQUIRE_FALSE(dense.is_dense());
+        REQUIRE(dense == range(n - 4, n, 1.0));
+        dense.merge(range(n - 4, n, 1.0), -1.0);
+        REQUIRE(dense.empty());
+    }
+    SECTION("Comparisons") {
+        REQUIRE(dense == range(0, n, 1.0));
+        REQUIRE(dense != range(0, n, 2.0));
+        REQUIRE(dense != testing_t(1, 1.0));
+    }
+}
@@ -0,0 +1,47 @@
+#include "../testing.hpp"
+#include <sigma/detail_/cached_value.hpp>
+
+TEMPLATE_TEST_CASE("CachedValue", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::detail_::CachedValue<value_t>;
+
+    testing_t cache(1.0);
+    std::size_t n_computed = 0;
+    auto compute           = [&n_computed]() {
+        ++n_computed;
+        return value_t(2.0);
+    };
+
+    SECTION("Valid on construction") {
+        REQUIRE(cache.valid());
+        REQUIRE(cache.get() == 1.0);
+        REQUIRE(cache.get_or_compute(compute) == 1.0);
+        REQUIRE(n_computed == 0);
+    }
+    SECTION("Computed once after invalidation") {
+        cache.invalidate();
+        REQUIRE_FALSE(cache.valid());
+        REQUIRE(cache.get_or_compute(compute) == 2.0);
+        REQUIRE(cache.get_or_compute(compute) == 2.0);
+        REQUIRE(n_computed == 1);
+    }
+    SECTION("Copies") {
+        cache.invalidate();
+        testing_t copy(cache);
+        REQUIRE_FALSE(copy.valid());
+        copy.set(3.0);
+        cache = copy;
+        REQUIRE(cache.valid());
+        REQUIRE(cache.get() == 3.0);
+    }
+    SECTION("Stamps") {
+        testing_t stamped(1.0, 5);
+        REQUIRE(stamped.valid(5));
+        REQUIRE_FALSE(stamped.valid());
+        REQUIRE(stamped.get_or_compute(compute, 6) == 2.0);
+        REQUIRE(stamped.get_or_compute(compute, 6) == 2.0);
+        REQUIRE(n_computed == 1);
+        stamped.invalidate();
+        REQUIRE_FALSE(stamped.valid(6));
+    }
+}
@@ -0,0 +1,184 @@
+#include "../testing.hpp"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include <sigma/detail_/deps_map.hpp>
+
+TEMPLATE_TEST_CASE("DepsMap", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::detail_::DepsMap<int, value_t>;
+
+    testing_t a(1, 2.0);
+    testing_t b(2, 3.0);
+
+    SECTION("Constructors") {
+        SECTION("Default") {
+            testing_t empty;
+            REQUIRE(empty.empty());
+            REQUIRE(empty.size() == 0);
+        }
+        SECTION("Single Dependency") {
+            REQUIRE(a.size() == 1);
+            REQUIRE(a.is_inline() == (testing_t::inline_size > 0));
+            REQUIRE(a.begin()->first == 1);
+            REQUIRE(a.begin()->second == 2.0);
+        }
+        SECTION("Move") {
+            testing_t moved(std::move(a));
+            REQUIRE(moved == testing_t(1, 2.0));
+            REQUIRE(a.empty());
+        }
+    }
+    SECTION("Lookup") {
+        REQUIRE(a.find(1) == a.begin());
+        REQUIRE(a.find(2) == a.end());
+        REQUIRE(a.count(1) == 1);
+        REQUIRE(a.count(2) == 0);
+    }
+    SECTION("Scale") {
+        SECTION("By non-zero") {
+            a.scale(2.0);
+            REQUIRE(a.find(1)->second == 4.0);
+        }
+        SECTION("By zero") {
+            a.scale(0.0);
+            REQUIRE(a.empty());
+        }
+        SECTION("Applied when merging") {
+            a.scale(2.0);
+            b.scale(-1.0);
+            a.merge(b, 2.0);
+            REQUIRE(a.find(1)->second == 4.0);
+            REQUIRE(a.find(2)->second == -6.0);
+        }
+        SECTION("Common factor is kept when merging") {
+            a.scale(3.0);
+            a.merge(testing_t(1, 2.0), 3.0);
+            REQUIRE(a == testing_t(1, 12.0));
+        }
+    }
+    SECTION("Merge") {
+        SECTION("Only new entries") {
+            a.merge(b, 2.0);
+            REQUIRE(a.size() == 2);
+            REQUIRE(a.find(1)->second == 2.0);
+            REQUIRE(a.find(2)->second == 6.0);
+        }
+        SECTION("Pre-existing and new entries") {
+            testing_t c(1, 1.0);
+            c.merge(b, 1.0);
+            c.merge(a, 1.0);
+            REQUIRE(c.size() == 2);
+            REQUIRE(c.find(1)->second == 3.0);
+            REQUIRE(c.find(2)->second == 3.0);
+        }
+        SECTION("Entries stay sorted") {
+            b.merge(a, 1.0);
+            REQUIRE(b.begin()->first == 1);
+            REQUIRE(std::next(b.begin())->first == 2);
+        }
+        SECTION("With itself") {
+            a.merge(a, 1.0);
+            REQUIRE(a.size() == 1);
+            REQUIRE(a.find(1)->second == 4.0);
+        }
+        SECTION("Cancelling entries are dropped") {
+            a.merge(b, 1.0);
+            a.merge(testing_t(1, 2.0), -1.0);
+            REQUIRE(a == b);
+        }
+        SECTION("By zero") {
+            a.merge(b, 0.0);
+            REQUIRE(a == testing_t(1, 2.0));
+        }
+    }
+    SECTION("Combine") {
+        using term_t = std::pair<const testing_t*, value_t>;
+        SECTION("No terms") {
+            std::vector<term_t> terms;
+            REQUIRE(testing_t::combine(terms.begin(), terms.end()).empty());
+        }
+        SECTION("Several terms") {
+            testing_t ab(a);
+            ab.merge(b, 1.0);
+            std::vector<term_t> terms{{&a, 2.0}, {&ab, 1.0}, {&b, 0.0}};
+            auto c = testing_t::combine(terms.begin(), terms.end());
+            testing_t corr(1, 6.0);
+            corr.merge(b, 1.0);
+            REQUIRE(c == corr);
+        }
+        SECTION("Cancelling entries are dropped") {
+            testing_t ab(a);
+            ab.merge(b, 1.0);
+            std::vector<term_t> terms{{&ab, 1.0}, {&a, -1.0}};
+            REQUIRE(testing_t::combine(terms.begin(), terms.end()) == b);
+        }
+        SECTION("Spills to the heap") {
+            auto n = testing_t::inline_size + 1;
+            std::vector<testing_t> maps;
+            for(std::size_t i = 0; i < n; ++i) {
+                maps.emplace_back(static_cast<int>(n - i), 1.0);
+            }
+            std::vector<term_t> terms;
+            for(const auto& map : maps) terms.emplace_back(&map, 2.0);
+            auto c = testing_t::combine(terms.begin(), terms.end());
+            REQUIRE(c.size() == n);
+            REQUIRE_FALSE(c.is_inline());
+            REQUIRE(std::is_sorted(c.begin(), c.end()));
+            REQUIRE(c.find(1)->second == 2.0);
+        }
+    }
+    SECTION("Spill to the heap") {
+        auto n = testing_t::inline_size + 1;
+        testing_t wide;
+        for(std::size_t i = 0; i < n; ++i) {
+            wide.merge(testing_t(static_cast<int>(n - i), 1.0), 1.0);
+        }
+        REQUIRE(wide.size() == n);
+        REQUIRE_FALSE(wide.is_inline());
+        REQUIRE(std::is_sorted(wide.begin(), wide.end()));
+
+        SECTION("Copies share storage until modified") {
+            testing_t copy(wide);
+            REQUIRE(copy == wide);
+            REQUIRE(copy.begin() == wide.begin());
+            copy.scale(2.0);
+            REQUIRE(copy.begin() == wide.begin());
+            REQUIRE(copy.find(1)->second == 2.0);
+            REQUIRE(wide.find(1)->second == 1.0);
+            copy.merge(testing_t(1, 1.0), 1.0);
+            REQUIRE(copy.begin() != wide.begin());
+            REQUIRE(copy.find(1)->second == 3.0);
+            REQUIRE(wide.find(1)->second == 1.0);
+        }
+
+        SECTION("Unshared storage is reused") {
+            testing_t sum(wide);
+            sum.merge(testing_t(1, 1.0), 1.0);
+            sum.merge(testing_t(1, 1.0), 1.0);
+            auto first = sum.begin();
+            sum.merge(testing_t(1, 1.0), 1.0);
+            REQUIRE(sum.begin() == first);
+            REQUIRE(sum.size() == n);
+            REQUIRE(sum.find(1)->second == 4.0);
+            REQUIRE(std::is_sorted(sum.begin(), sum.end()));
+        }
+
+        wide.merge(testing_t(1, 1.0), -1.0);
+        REQUIRE(wide.size() == n - 1);
+        REQUIRE(wide.is_inline());
+        REQUIRE(wide.count(1) == 0);
+    }
+    SECTION("Prune") {
+        testing_t c(3, 0.0);
+        REQUIRE(c.size() == 1);
+        c.prune();
+        REQUIRE(c.empty());
+    }
+    SECTION("Comparisons") {
+        REQUIRE(a == testing_t(1, 2.0));
+        REQUIRE(a != testing_t(1, 3.0));
+        REQUIRE(a != b);
+    }
+}
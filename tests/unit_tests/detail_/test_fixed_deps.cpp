@@ -0,0 +1,67 @@
+#include "../testing.hpp"
+#include <sigma/detail_/fixed_deps.hpp>
+
+TEMPLATE_TEST_CASE("FixedDeps", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::detail_::FixedDeps<value_t, 3>;
+
+    testing_t a(0, 2.0);
+    testing_t b(2, 3.0);
+
+    SECTION("Constructors") {
+        SECTION("Default") {
+            testing_t empty;
+            REQUIRE(empty.empty());
+            REQUIRE(empty.size() == 0);
+            REQUIRE(empty.begin() == empty.end());
+        }
+        SECTION("Single Dependency") {
+            REQUIRE(a.size() == 1);
+            REQUIRE(a.begin()->first == 0);
+            REQUIRE(a.begin()->second == 2.0);
+            REQUIRE(a.gradient()[1] == 0.0);
+        }
+    }
+    SECTION("Lookup") {
+        REQUIRE(a.find(0) == a.begin());
+        REQUIRE(a.find(1) == a.end());
+        REQUIRE(a.find(5) == a.end());
+        REQUIRE(a.count(0) == 1);
+        REQUIRE(b.count(0) == 0);
+    }
+    SECTION("Iteration skips zeros") {
+        a.merge(b, 1.0);
+        auto it = a.begin();
+        REQUIRE(it->first == 0);
+        ++it;
+        REQUIRE(it->first == 2);
+        ++it;
+        REQUIRE(it == a.end());
+    }
+    SECTION("Scale") {
+        a.scale(2.0);
+        REQUIRE(a.find(0)->second == 4.0);
+        a.scale(0.0);
+        REQUIRE(a.empty());
+    }
+    SECTION("Merge") {
+        SECTION("New entries") {
+            a.merge(b, 2.0);
+            REQUIRE(a.size() == 2);
+            REQUIRE(a.find(2)->second == 6.0);
+        }
+        SECTION("With itself") {
+            a.merge(a, 1.0);
+            REQUIRE(a == testing_t(0, 4.0));
+        }
+        SECTION("Cancelling entries") {
+            a.merge(testing_t(0, 1.0), -2.0);
+            REQUIRE(a.empty());
+        }
+    }
+    SECTION("Comparisons") {
+        REQUIRE(a == testing_t(0, 2.0));
+        REQUIRE(a != testing_t(1, 2.0));
+        REQUIRE(a != b);
+    }
+}
@@ -0,0 +1,86 @@
+#include "../testing.hpp"
+#include <sigma/detail_/hash_deps.hpp>
+
+TEMPLATE_TEST_CASE("HashDeps", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::detail_::HashDeps<int, value_t>;
+
+    auto n = static_cast<int>(testing_t::min_hash_size) + 8;
+    auto range = [](int first, int last, int stride, value_t deriv) {
+        testing_t deps;
+        for(int i = first; i < last; ++i) {
+            deps.merge(testing_t(stride * i, deriv), 1.0);
+        }
+        return deps;
+    };
+
+    testing_t wide = range(0, n, 3, 1.0);
+
+    SECTION("Starts out sorted") {
+        testing_t a(1, 2.0);
+        REQUIRE_FALSE(a.is_hashed());
+        REQUIRE(a.size() == 1);
+        REQUIRE(a.find(1)->second == 2.0);
+    }
+    SECTION("Moves to the table once wide") {
+        REQUIRE(wide.is_hashed());
+        REQUIRE(wide.size() == static_cast<std::size_t>(n));
+        REQUIRE(wide.find(3)->second == 1.0);
+        REQUIRE(wide.count(4) == 0);
+        std::size_t count = 0;
+        for(const auto& [key, deriv] : wide) {
+            REQUIRE(key % 3 == 0);
+            REQUIRE(deriv == 1.0);
+            ++count;
+        }
+        REQUIRE(count == wide.size());
+    }
+    SECTION("Scale") {
+        wide.scale(2.0);
+        REQUIRE(wide.find(3)->second == 2.0);
+        wide.scale(0.0);
+        REQUIRE(wide.empty());
+        REQUIRE_FALSE(wide.is_hashed());
+    }
+    SECTION("Table with sorted") {
+        wide.merge(testing_t(1, 3.0), 2.0);
+        wide.merge(testing_t(3, 1.0), 1.0);
+        REQUIRE(wide.find(1)->second == 6.0);
+        REQUIRE(wide.find(3)->second == 2.0);
+        REQUIRE(wide.size() == static_cast<std::size_t>(n + 1));
+    }
+    SECTION("Sorted with table") {
+        testing_t a(3, 2.0);
+        a.merge(wide, 3.0);
+        REQUIRE(a.is_hashed());
+        REQUIRE(a.find(3)->second == 5.0);
+        REQUIRE(a.find(6)->second == 3.0);
+    }
+    SECTION("Table with table") {
+        wide.merge(range(0, 2 * n, 1, 1.0), 2.0);
+        REQUIRE(wide.find(3)->second == 3.0);
+        REQUIRE(wide.find(4)->second == 2.0);
+        REQUIRE(wide.find(3 * (n - 1))->second == 1.0);
+    }
+    SECTION("With itself") {
+        wide.merge(wide, 1.0);
+        REQUIRE(wide.find(0)->second == 2.0);
+    }
+    SECTION("Copies share storage until modified") {
+        testing_t copy(wide);
+        copy.merge(testing_t(0, 1.0), 1.0);
+        REQUIRE(copy.find(0)->second == 2.0);
+        REQUIRE(wide.find(0)->second == 1.0);
+    }
+    SECTION("Goes back to sorted once emptied") {
+        wide.merge(range(0, n - 4, 3, 1.0), -1.0);
+        REQUIRE_FALSE(wide.is_hashed());
+        REQUIRE(wide == range(n - 4, n, 3, 1.0));
+        REQUIRE(wide.begin()->first == 3 * (n - 4));
+    }
+    SECTION("Comparisons") {
+        REQUIRE(wide == range(0, n, 3, 1.0));
+        REQUIRE(wide != range(0, n, 3, 2.0));
+        REQUIRE(wide != range(1, n + 1, 3, 1.0));
+    }
+}
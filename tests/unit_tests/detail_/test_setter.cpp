@@ -19,20 +19,19 @@ TEMPLATE_TEST_CASE("Setter", "", sigma::UFloat, sigma::UDouble) {
     }
     SECTION("Update the derivatives") {
         SECTION("Only existing derivatives") {
-            // Don't update the first time, making sure that the flag works
-            testing_a.update_derivatives(2.0, false);
-            test_uncertain(a, 3.0, 0.3, 1);
-            // Should be the same update_derivative(4.0)
+            // The standard deviation follows without an explicit update
             testing_a.update_derivatives(2.0);
+            test_uncertain(a, 3.0, 0.6, 1);
+            // Should be the same update_derivative(4.0)
+            testing_a.update_derivatives(2.0, true);
             test_uncertain(a, 3.0, 1.2, 1);
         }
         SECTION("One list of derivatives") {
             SECTION("Only pre-existing entries in map") {
-                // Don't update the first time, making sure that the flag works
-                testing_a.update_derivatives(a.deps(), 1.0, false);
-                test_uncertain(a, 3.0, 0.3, 1);
-                // Check for changes across both calls
                 testing_a.update_derivatives(a.deps(), 1.0);
+                test_uncertain(a, 3.0, 0.6, 1);
+                // Check for changes across both calls
+                testing_a.update_derivatives(a.deps(), 1.0, true);
                 test_uncertain(a, 3.0, 1.2, 1);
             }
             SECTION("Only new entries in map") {
@@ -50,11 +49,17 @@ TEMPLATE_TEST_CASE("Setter", "", sigma::UFloat, sigma::UDouble) {
         }
     }
     SECTION("Update the standard deviation") {
-        // Change derivatives without updating the standard deviation
-        testing_a.update_derivatives(0.0, false);
-        test_uncertain(a, 3.0, 0.3, 1);
-        // Explicitly update the standard deviation
-        testing_a.update_sd();
-        test_uncertain(a, 3.0, 0.0, 0);
+        SECTION("Computed on demand") {
+            testing_a.update_derivatives(b.deps(), 1.0);
+            test_uncertain(a, 3.0, 0.5, 2);
+            // Removing all contributions
+            testing_a.update_derivatives(0.0);
+            test_uncertain(a, 3.0, 0.0, 0);
+        }
+        SECTION("Explicit update") {
+            testing_a.update_derivatives(2.0);
+            testing_a.update_sd();
+            test_uncertain(a, 3.0, 0.6, 1);
+        }
     }
 }
@@ -0,0 +1,57 @@
+#include "../testing.hpp"
+#include <sigma/detail_/source_registry.hpp>
+#include <vector>
+
+TEMPLATE_TEST_CASE("SourceRegistry", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::detail_::SourceRegistry<value_t>;
+
+    auto& registry = testing_t::instance();
+
+    SECTION("Single instance") { REQUIRE(&registry == &testing_t::instance()); }
+    SECTION("IDs are assigned in increasing order") {
+        auto first  = registry.add(0.1);
+        auto second = registry.add(0.2);
+        REQUIRE(first < second);
+        REQUIRE(registry.size() > second);
+    }
+    SECTION("Standard deviations are stored") {
+        auto id = registry.add(-0.5);
+        REQUIRE(registry.sd(id) == value_t(-0.5));
+    }
+    SECTION("Changing a standard deviation") {
+        auto id         = registry.add(0.5);
+        auto generation = registry.generation();
+        registry.set_sd(id, 0.25);
+        REQUIRE(registry.sd(id) == value_t(0.25));
+        REQUIRE(registry.generation() != generation);
+        REQUIRE(registry.generation() != 0);
+    }
+    SECTION("Recycling IDs") {
+        std::vector<typename testing_t::id_t> ids;
+        auto* previous = registry.record(&ids);
+        auto first     = registry.add(0.1);
+        auto second    = registry.add(0.2);
+        REQUIRE(registry.record(previous) == &ids);
+        REQUIRE(ids == std::vector{first, second});
+
+        // Other tests on this thread may have released IDs as well
+        registry.release(ids);
+        auto size   = registry.size();
+        auto third  = registry.add(0.3);
+        auto fourth = registry.add(0.4);
+        REQUIRE(third < fourth);
+        REQUIRE(fourth <= second);
+        REQUIRE(registry.sd(third) == value_t(0.3));
+        REQUIRE(registry.size() == size);
+    }
+    SECTION("Spanning multiple chunks") {
+        std::vector<typename testing_t::id_t> ids;
+        for(std::size_t i = 0; i < 5000; ++i) {
+            ids.push_back(registry.add(static_cast<value_t>(i)));
+        }
+        for(std::size_t i = 0; i < ids.size(); ++i) {
+            REQUIRE(registry.sd(ids[i]) == static_cast<value_t>(i));
+        }
+    }
+}
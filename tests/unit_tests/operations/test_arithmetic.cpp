@@ -75,6 +75,11 @@ TEMPLATE_TEST_CASE("Arithmetic", "", sigma::UFloat, sigma::UDouble) {
             x *= b;
             test_uncertain(x, 2.0, 0.2828, 2);
         }
+        SECTION("By itself") {
+            auto x = a;
+            x *= x;
+            test_uncertain(x, 1.0, 0.2, 1);
+        }
         SECTION("By Certain") {
             int two = 2;
             auto x  = a;
@@ -117,4 +122,31 @@ TEMPLATE_TEST_CASE("Arithmetic", "", sigma::UFloat, sigma::UDouble) {
             test_uncertain(y, 2.0, 0.2, 1);
         }
     }
+    SECTION("Temporaries") {
+        SECTION("Addition") {
+            test_uncertain((a + b) + c, 6.0, 0.3742, 3);
+            test_uncertain(a + (b + c), 6.0, 0.3742, 3);
+            test_uncertain((a + b) + (b + c), 8.0, 0.5099, 3);
+            test_uncertain((a + b) + 1.0, 4.0, 0.2236, 2);
+            test_uncertain(1.0 + (a + b), 4.0, 0.2236, 2);
+        }
+        SECTION("Subtraction") {
+            test_uncertain(c - (a + b), 0.0, 0.3742, 3);
+            test_uncertain((a - b) - (b - c), 0.0, 0.5099, 3);
+            test_uncertain((a + b) - 1.0, 2.0, 0.2236, 2);
+            test_uncertain(2.0 - (a + b), -1.0, 0.2236, 2);
+        }
+        SECTION("Multiplication") {
+            test_uncertain((a * b) * c, 6.0, 1.0392, 3);
+            test_uncertain(c * (a * b), 6.0, 1.0392, 3);
+            test_uncertain((a + b) * (b + c), 15.0, 1.9026, 3);
+            test_uncertain(2.0 * (a + b), 6.0, 0.4472, 2);
+        }
+        SECTION("Division") {
+            test_uncertain((a + b) / (c + c), 0.5, 0.0624, 3);
+            test_uncertain(c / (a + b), 1.0, 0.1247, 3);
+            test_uncertain((a + b) / 2.0, 1.5, 0.1118, 2);
+            test_uncertain(6.0 / (a + b), 2.0, 0.1491, 2);
+        }
+    }
 }
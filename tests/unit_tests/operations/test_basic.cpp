@@ -30,6 +30,17 @@ TEMPLATE_TEST_CASE("Basic", "", sigma::UFloat, sigma::UDouble) {
         test_uncertain(sigma::fmod(d, 2.0), 1.0, 0.3, 1);
         test_uncertain(sigma::fmod(3.0, c), 1.0, 0.2, 1);
     }
+    SECTION("Fused multiply-add") {
+        test_uncertain(sigma::fma(c, d, a), 7.0, 0.8544, 3);
+        auto eager = c * d + a;
+        REQUIRE(sigma::fma(c, d, a).sd() == Catch::Approx(eager.sd()));
+        test_uncertain(sigma::fma(a, a, -a), 0.0, 0.1, 1);
+    }
+    SECTION("Linear interpolation") {
+        test_uncertain(sigma::lerp(a, c, 0.25), 1.25, 0.0901, 2);
+        test_uncertain(sigma::lerp(a, c, b), 2.3, 0.2802, 3);
+        test_uncertain(sigma::lerp(a, a, b), 1.0, 0.1, 1);
+    }
     SECTION("Truncation") {
         test_uncertain(sigma::trunc(b), 1.0, 0.0, 0);
         test_uncertain(sigma::trunc(-b), -1.0, 0.0, 0);
@@ -1,4 +1,5 @@
 #include "../testing.hpp"
+#include <cmath>
 #include <sigma/sigma.hpp>
 
 using testing::test_uncertain;
@@ -21,4 +22,27 @@ TEMPLATE_TEST_CASE("Error Function and Gamma", "", sigma::UFloat,
     SECTION("Gamma Function Natural Logarithm") {
         test_uncertain(sigma::lgamma(a), 0.0, 0.0577, 1);
     }
+    SECTION("Digamma Function") {
+        test_uncertain(sigma::digamma(a), -0.5772, 0.1645, 1);
+        test_uncertain(sigma::digamma(testing_t(-0.5, 0.01)), 0.0365, 0.0893,
+                       1);
+        REQUIRE(std::isnan(sigma::digamma(testing_t(0.0, 0.1)).mean()));
+    }
+    SECTION("Beta Function") {
+        auto x = testing_t(2.0, 0.1);
+        auto y = testing_t(3.0, 0.2);
+        test_uncertain(sigma::beta(x, y), 0.0833, 0.0133, 2);
+        test_uncertain(sigma::beta(x, 3.0), 0.0833, 0.0090, 1);
+        test_uncertain(sigma::beta(2.0, y), 0.0833, 0.0097, 1);
+        test_uncertain(sigma::beta(x, x), 0.1667, 0.0278, 1);
+    }
+    SECTION("Beta Function Natural Logarithm") {
+        auto x = testing_t(2.0, 0.1);
+        auto y = testing_t(3.0, 0.2);
+        test_uncertain(sigma::lbeta(x, y), -2.4849, 0.1592, 2);
+        test_uncertain(sigma::lbeta(2.0, y), -2.4849, 0.1167, 1);
+        auto diff = sigma::lbeta(x, y) - sigma::log(sigma::beta(x, y));
+        REQUIRE(diff.mean() == Catch::Approx(0.0).margin(1.0e-4));
+        REQUIRE(diff.sd() == Catch::Approx(0.0).margin(1.0e-4));
+    }
 }
@@ -68,5 +68,9 @@ TEMPLATE_TEST_CASE("Exponents", "", sigma::UFloat, sigma::UDouble) {
             test_uncertain(sigma::hypot(a, 2.0), 2.2361, 0.0447, 1);
             test_uncertain(sigma::hypot(2.0, a), 2.2361, 0.0447, 1);
         }
+        SECTION("Three Uncertain Variables") {
+            test_uncertain(sigma::hypot(a, b, c), 4.5826, 0.3606, 3);
+            test_uncertain(sigma::hypot(a, a, a), 1.7321, 0.1732, 1);
+        }
     }
 }
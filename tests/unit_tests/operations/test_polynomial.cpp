@@ -0,0 +1,42 @@
+#include "../testing.hpp"
+#include <array>
+#include <sigma/sigma.hpp>
+#include <vector>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Polynomial", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto x = testing_t(2.0, 0.2);
+
+    SECTION("Certain Coefficients") {
+        std::vector<double> c{1.0, 2.0, 3.0};
+        test_uncertain(sigma::polyval(c, x), 17.0, 2.8, 1);
+        std::array<double, 1> constant{5.0};
+        test_uncertain(sigma::polyval(constant, x), 5.0, 0.0, 0);
+        std::vector<double> none;
+        test_uncertain(sigma::polyval(none, x), 0.0, 0.0, 0);
+    }
+    SECTION("Uncertain Coefficients") {
+        auto y = testing_t(5.0, 0.5);
+        std::vector<testing_t> c{testing_t(1.0, 0.1), testing_t(2.0, 0.2),
+                                 testing_t(4.0, 0.4)};
+        test_uncertain(sigma::polyval(c, y), 111.0, 23.2811, 4);
+        auto eager = c[0] + c[1] * y + c[2] * y * y;
+        REQUIRE(sigma::polyval(c, y).sd() == Catch::Approx(eager.sd()));
+    }
+    SECTION("Matches repeated multiplication") {
+        std::array<double, 9> c{1.0, -2.0, 0.5, 0.25, -0.125,
+                                0.1, 0.05, -0.01, 0.001};
+        auto p     = sigma::polyval(c, x);
+        auto eager = testing_t(c[0]);
+        auto power = testing_t(1.0);
+        for(std::size_t i = 1; i < c.size(); ++i) {
+            power = power * x;
+            eager = eager + c[i] * power;
+        }
+        REQUIRE(p.mean() == Catch::Approx(eager.mean()));
+        REQUIRE(p.sd() == Catch::Approx(eager.sd()));
+    }
+}
@@ -0,0 +1,54 @@
+#include "../testing.hpp"
+#include <array>
+#include <numeric>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+#include <vector>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Reductions", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    std::vector<testing_t> x{testing_t(1.0, 0.1), testing_t(2.0, 0.2),
+                             testing_t(3.0, 0.3), testing_t(4.0, 0.4)};
+    std::array<double, 4> w{1.0, 2.0, 3.0, 4.0};
+
+    SECTION("Sum") {
+        test_uncertain(sigma::sum(x), 10.0, 0.5477, 4);
+        auto eager = std::accumulate(x.begin(), x.end(), testing_t{});
+        REQUIRE(sigma::sum(x).sd() == Catch::Approx(eager.sd()));
+        test_uncertain(sigma::sum(std::vector<testing_t>{}), 0.0, 0.0, 0);
+    }
+    SECTION("Sum with shared dependencies") {
+        std::vector<testing_t> y{x[0], -x[0], x[1] + x[2]};
+        test_uncertain(sigma::sum(y), 5.0, 0.3606, 2);
+    }
+    SECTION("Mean") {
+        test_uncertain(sigma::mean(x), 2.5, 0.1369, 4);
+        auto empty = sigma::mean(std::vector<testing_t>{});
+        REQUIRE(empty.mean() != empty.mean());
+        REQUIRE(empty.deps().empty());
+    }
+    SECTION("Dot product") {
+        test_uncertain(sigma::dot(w, x), 30.0, 1.8815, 4);
+        test_uncertain(sigma::dot(x, w), 30.0, 1.8815, 4);
+        test_uncertain(sigma::dot(x, x), 30.0, 3.7630, 4);
+        REQUIRE_THROWS_AS(sigma::dot(x, std::vector<double>{1.0}),
+                          std::invalid_argument);
+    }
+    SECTION("Weighted mean") {
+        test_uncertain(sigma::weighted_mean(x, w), 3.0, 0.1881, 4);
+        auto eager = sigma::dot(x, x) / sigma::sum(x);
+        auto fused = sigma::weighted_mean(x, x);
+        REQUIRE(fused.mean() == Catch::Approx(eager.mean()));
+        REQUIRE(fused.sd() == Catch::Approx(eager.sd()));
+        REQUIRE_THROWS_AS(sigma::weighted_mean(x, std::vector<double>{}),
+                          std::invalid_argument);
+    }
+    SECTION("Many variables") {
+        std::vector<testing_t> many;
+        for(std::size_t i = 0; i < 100; ++i) many.emplace_back(1.0, 0.1);
+        test_uncertain(sigma::sum(many), 100.0, 1.0, 100);
+    }
+}
@@ -0,0 +1,69 @@
+#include "testing.hpp"
+#include <cmath>
+#include <sigma/sigma.hpp>
+
+using dual_t = sigma::Dual<double, 2>;
+
+namespace {
+
+/// Checks the value and gradient of a dual number
+void check_dual(const dual_t& x, double value, double dx, double dy) {
+    REQUIRE(x.value() == Catch::Approx(value));
+    REQUIRE(x.derivative(0) == Catch::Approx(dx).margin(1.0e-12));
+    REQUIRE(x.derivative(1) == Catch::Approx(dy).margin(1.0e-12));
+}
+
+} // namespace
+
+TEST_CASE("Dual") {
+    auto x = dual_t::variable(2.0, 0);
+    auto y = dual_t::variable(3.0, 1);
+
+    SECTION("Constants") {
+        check_dual(dual_t(), 0.0, 0.0, 0.0);
+        check_dual(dual_t(4.0), 4.0, 0.0, 0.0);
+        check_dual(x, 2.0, 1.0, 0.0);
+        check_dual(y, 3.0, 0.0, 1.0);
+    }
+    SECTION("Arithmetic") {
+        check_dual(-x, -2.0, -1.0, 0.0);
+        check_dual(x + y, 5.0, 1.0, 1.0);
+        check_dual(x - y, -1.0, 1.0, -1.0);
+        check_dual(x * y, 6.0, 3.0, 2.0);
+        check_dual(x / y, 2.0 / 3.0, 1.0 / 3.0, -2.0 / 9.0);
+    }
+    SECTION("With Plain Numbers") {
+        check_dual(x + 1, 3.0, 1.0, 0.0);
+        check_dual(1.0 - x, -1.0, -1.0, 0.0);
+        check_dual(2.0 * y, 6.0, 0.0, 2.0);
+        check_dual(1.0 / x, 0.5, -0.25, 0.0);
+    }
+    SECTION("Compound Assignment") {
+        auto z = x;
+        z *= y;
+        z += 1.0;
+        check_dual(z, 7.0, 3.0, 2.0);
+    }
+    SECTION("Comparisons") {
+        REQUIRE(x < y);
+        REQUIRE(x < 3.0);
+        REQUIRE(1.0 < x);
+        REQUIRE(y >= 3.0);
+        REQUIRE(x != y);
+        REQUIRE(x == 2.0);
+    }
+    SECTION("Functions") {
+        check_dual(sigma::sin(x * y), std::sin(6.0), 3.0 * std::cos(6.0),
+                   2.0 * std::cos(6.0));
+        check_dual(sigma::exp(x), std::exp(2.0), std::exp(2.0), 0.0);
+        check_dual(sigma::log(y), std::log(3.0), 0.0, 1.0 / 3.0);
+        check_dual(sigma::abs(-x), 2.0, 1.0, 0.0);
+        check_dual(sigma::pow(x, 3), 8.0, 12.0, 0.0);
+        check_dual(sigma::pow(2.0, y), 8.0, 0.0, 8.0 * std::log(2.0));
+        check_dual(sigma::pow(x, y), 8.0, 12.0, 8.0 * std::log(2.0));
+        check_dual(sigma::atan2(y, x), std::atan2(3.0, 2.0), -3.0 / 13.0,
+                   2.0 / 13.0);
+        check_dual(sigma::hypot(x, y), std::sqrt(13.0), 2.0 / std::sqrt(13.0),
+                   3.0 / std::sqrt(13.0));
+    }
+}
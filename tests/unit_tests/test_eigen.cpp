@@ -134,6 +134,32 @@ TEMPLATE_TEST_CASE("Eigen Matrix with Uncertain Elements", "", sigma::UFloat,
             test_uncertain(evectors(1, 1), -0.8507, 0.0197, 3);
         }
     }
+
+    SECTION("Find Root") {
+        using vector_t = Eigen::Matrix<value_t, 2, 1>;
+        auto f         = [](const auto& x, auto p, auto q) {
+            std::decay_t<decltype(x)> r;
+            r << x(0) * x(1) - p, x(0) - x(1) - q;
+            return r;
+        };
+        auto root = sigma::find_root(f, vector_t(1.0, 0.5), u(6.0), u(1.0));
+        test_uncertain(root(0), 3.0, 0.1342, 2);
+        test_uncertain(root(1), 2.0, 0.1265, 2);
+    }
+    SECTION("Find Root of a Singular System") {
+        using vector_t = Eigen::Matrix<value_t, 2, 1>;
+        auto f         = [](const auto& x, auto p) {
+            std::decay_t<decltype(x)> r;
+            auto sum = x(0) + x(1) - p;
+            r << sum, sum + sum;
+            return r;
+        };
+        // Singular during the iterations, and at a root
+        REQUIRE_THROWS_AS(sigma::find_root(f, vector_t(0.0, 0.0), u(3.0)),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(sigma::find_root(f, vector_t(1.0, 2.0), u(3.0)),
+                          std::runtime_error);
+    }
 }
 
 #endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,87 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Expression", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+    auto c = testing_t(3.0, 0.3);
+    auto d = testing_t(4.0, 0.4);
+    auto e = testing_t(5.0, 0.5);
+
+    SECTION("Leaf") {
+        testing_t x = sigma::lazy(a);
+        REQUIRE(x == a);
+    }
+    SECTION("Negation") {
+        testing_t x = -sigma::lazy(a);
+        test_uncertain(x, -1.0, 0.1, 1);
+    }
+    SECTION("Arithmetic") {
+        testing_t sum = sigma::lazy(a) + b;
+        test_uncertain(sum, 3.0, 0.2236, 2);
+        testing_t difference = sigma::lazy(a) - b;
+        test_uncertain(difference, -1.0, 0.2236, 2);
+        testing_t product = sigma::lazy(a) * b;
+        test_uncertain(product, 2.0, 0.2828, 2);
+        testing_t quotient = sigma::lazy(a) / b;
+        test_uncertain(quotient, 0.5, 0.0707, 2);
+    }
+    SECTION("With Certain") {
+        testing_t x = 2.0 * sigma::lazy(a) + 1.0;
+        test_uncertain(x, 3.0, 0.2, 1);
+        testing_t y = 1.0 / (sigma::lazy(b) - 4.0);
+        test_uncertain(y, -0.5, 0.05, 1);
+    }
+    SECTION("Matches eager evaluation") {
+        testing_t fused = sigma::lazy(a) * b + c / sigma::lazy(d) - e;
+        auto eager      = a * b + c / d - e;
+        REQUIRE(fused.mean() == Catch::Approx(eager.mean()));
+        REQUIRE(fused.sd() == Catch::Approx(eager.sd()));
+        REQUIRE(fused.deps().size() == eager.deps().size());
+        for(const auto& [dep, deriv] : eager.deps()) {
+            REQUIRE(fused.deps().find(dep)->second == Catch::Approx(deriv));
+        }
+    }
+    SECTION("Repeated variables") {
+        testing_t x = sigma::lazy(a) * a - a;
+        test_uncertain(x, 0.0, 0.1, 1);
+        testing_t y = sigma::lazy(a) - a;
+        test_uncertain(y, 0.0, 0.0, 0);
+    }
+    SECTION("Shared dependencies") {
+        auto ab       = a + b;
+        testing_t x   = sigma::lazy(ab) - a + ab * 2.0;
+        auto expected = ab - a + ab * 2.0;
+        test_uncertain(x, expected.mean(), expected.sd(), 2);
+    }
+    SECTION("Many dependencies") {
+        testing_t sum;
+        testing_t other;
+        for(std::size_t i = 0; i < 10; ++i) {
+            sum += testing_t(1.0, 0.1);
+            other += testing_t(2.0, 0.1);
+        }
+        testing_t x   = sigma::lazy(sum) * other + sum;
+        auto expected = sum * other + sum;
+        test_uncertain(x, expected.mean(), expected.sd(), 20);
+    }
+    SECTION("Evaluate") {
+        auto x = (sigma::lazy(a) + b).evaluate();
+        REQUIRE(std::is_same_v<decltype(x), testing_t>);
+        test_uncertain(x, 3.0, 0.2236, 2);
+    }
+}
+
+TEST_CASE("Expression of FixedUncertain") {
+    using testing_t = sigma::FixedUncertain<double, 2>;
+    auto a          = testing_t(1.0, 0.1, 0);
+    auto b          = testing_t(2.0, 0.2, 1);
+
+    testing_t x   = sigma::lazy(a) * b + a;
+    auto expected = a * b + a;
+    test_uncertain(x, expected.mean(), expected.sd(), 2);
+}
@@ -0,0 +1,75 @@
+#ifdef ENABLE_EIGEN_SUPPORT
+
+#include "testing.hpp"
+#include <Eigen/Dense>
+#include <cmath>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+#include <vector>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Fit", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using value_t   = typename testing_t::value_t;
+    using params_t  = Eigen::Matrix<value_t, 2, 1>;
+
+    auto line = [](auto x, const auto& p) { return p(0) + p(1) * x; };
+
+    SECTION("Linear Model") {
+        std::vector<value_t> x{0.0, 1.0, 2.0, 4.0, 5.0};
+        std::vector<testing_t> y;
+        for(auto xi : x) y.emplace_back(1.0 + 2.0 * xi, 0.1);
+
+        auto p = sigma::fit(line, x, y, params_t(0.0, 0.0));
+        test_uncertain(p(0), 1.0, 0.0731, 5);
+        test_uncertain(p(1), 2.0, 0.0241, 5);
+        // The parameters are anticorrelated
+        test_uncertain(p(0) + p(1), 3.0, 0.0560, 5);
+    }
+    SECTION("Nonlinear Model") {
+        auto decay = [](auto x, const auto& p) {
+            using std::exp;
+            return p(0) * exp(-p(1) * x);
+        };
+        std::vector<value_t> t;
+        std::vector<testing_t> counts;
+        for(int i = 0; i < 10; ++i) {
+            t.push_back(i);
+            counts.emplace_back(100.0 * std::exp(-0.1 * i), 1.0);
+        }
+        auto p = sigma::fit(decay, t, counts, params_t(50.0, 0.5));
+        REQUIRE(p(0).mean() == Catch::Approx(100.0).epsilon(1.0e-4));
+        REQUIRE(p(1).mean() == Catch::Approx(0.1).epsilon(1.0e-4));
+        REQUIRE(p(0).deps().size() == 10);
+        REQUIRE(p(0).sd() > 0.0);
+    }
+    SECTION("Uncertain Independent Variable") {
+        auto slope = [](auto x, const auto& p) { return p(0) * x; };
+        std::vector<testing_t> x{testing_t(1.0, 0.1), testing_t(2.0, 0.1)};
+        std::vector<testing_t> y{testing_t(2.0, 0.2), testing_t(4.0, 0.2)};
+        auto p = sigma::fit(slope, x, y, Eigen::Matrix<value_t, 1, 1>(1.0));
+        test_uncertain(p(0), 2.0, 0.1265, 4);
+    }
+    SECTION("Parameters Not Determined by the Data") {
+        std::vector<value_t> x{0.0, 1.0, 2.0};
+        std::vector<testing_t> y;
+        for(auto xi : x) y.emplace_back(2.0 * xi, 0.1);
+        auto unused = [](auto x, const auto& p) { return p(0) * x; };
+        REQUIRE_THROWS_AS(sigma::fit(unused, x, y, params_t(1.0, 1.0)),
+                          std::runtime_error);
+        auto sum = [](auto x, const auto& p) { return p(0) * x + p(1) * x; };
+        REQUIRE_THROWS_AS(sigma::fit(sum, x, y, params_t(1.0, 0.0)),
+                          std::runtime_error);
+    }
+    SECTION("Invalid Data") {
+        std::vector<value_t> x{0.0, 1.0};
+        std::vector<testing_t> y{testing_t(1.0, 0.1)};
+        REQUIRE_THROWS_AS(sigma::fit(line, x, y, params_t(0.0, 0.0)),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(sigma::fit(line, y, y, params_t(0.0, 0.0)),
+                          std::invalid_argument);
+    }
+}
+
+#endif // ENABLE_EIGEN_SUPPORT
@@ -0,0 +1,117 @@
+#include "testing.hpp"
+#include <atomic>
+#include <cstddef>
+#include <memory_resource>
+#include <sigma/sigma.hpp>
+#include <vector>
+
+using testing::test_uncertain;
+
+namespace {
+
+/// Forwards to another resource, counting the allocations made
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream) :
+      m_upstream_(upstream) {}
+
+    std::atomic<std::size_t> allocations{0};
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return m_upstream_->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes,
+                       std::size_t alignment) override {
+        m_upstream_->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* m_upstream_;
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Graph Evaluation", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using tape_t    = sigma::Tape<testing_t>;
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+    auto c = testing_t(3.0, 0.3);
+
+    tape_t tape;
+    auto x = tape.variable(a);
+    auto y = tape.variable(b);
+    auto z = tape.variable(c);
+
+    SECTION("Matches eager evaluation") {
+        auto u = x * sin(y) + exp(z / x);
+        auto v = u - pow(y, 2) * z;
+        auto w = x * x;
+        std::vector<typename tape_t::variable_t> outputs{u, v, w, x};
+        auto results = sigma::evaluate(tape, outputs, 2);
+        REQUIRE(results.size() == 4);
+
+        auto eager_u = a * sigma::sin(b) + sigma::exp(c / a);
+        auto eager_v = eager_u - sigma::pow(b, 2) * c;
+        test_uncertain(results[0], eager_u.mean(), eager_u.sd(), 3);
+        test_uncertain(results[1], eager_v.mean(), eager_v.sd(), 3);
+        test_uncertain(results[2], 1.0, 0.2, 1);
+        REQUIRE(results[3] == a);
+    }
+    SECTION("Matches the backward sweep") {
+        // Independent channels, each with its own correction
+        std::vector<typename tape_t::variable_t> channels;
+        for(int i = 0; i < 50; ++i) {
+            auto channel = x * (1.0 + 0.01 * i);
+            for(int j = 0; j < 20; ++j) channel = channel * 0.99 + y * 0.01;
+            channels.push_back(channel * z);
+        }
+        for(std::size_t n_threads : {1, 4, 0}) {
+            auto results = sigma::evaluate(tape, channels, n_threads);
+            for(std::size_t i = 0; i < channels.size(); ++i) {
+                auto expected = tape.evaluate(channels[i]);
+                test_uncertain(results[i], expected.mean(), expected.sd(), 3);
+            }
+        }
+    }
+    SECTION("Long serial computation") {
+        auto chain = x;
+        for(int i = 0; i < 1000; ++i) chain = chain * 0.999 + y * 0.001;
+        std::vector<typename tape_t::variable_t> outputs{chain};
+        auto results  = sigma::evaluate(tape, outputs);
+        auto expected = tape.evaluate(chain);
+        test_uncertain(results[0], expected.mean(), expected.sd(), 2);
+    }
+    SECTION("Thread-safe memory resource") {
+        // Enough sources for the dependencies to leave the instances
+        auto sum = x + y + z;
+        for(int i = 0; i < 4; ++i) sum = sum + tape.variable(testing_t(i, 0.1));
+        std::vector<typename tape_t::variable_t> channels;
+        for(int i = 0; i < 20; ++i) channels.push_back(sum * (1.0 + i) + x);
+
+        std::pmr::synchronized_pool_resource pool;
+        CountingResource shared(&pool);
+        std::pmr::unsynchronized_pool_resource arena;
+        CountingResource caller(&arena);
+        {
+            sigma::ScopedMemoryResource scope(&caller);
+            auto results = sigma::evaluate(tape, channels, 4, &shared);
+            REQUIRE(sigma::get_memory_resource() == &caller);
+            REQUIRE(caller.allocations == 0);
+            for(std::size_t i = 0; i < channels.size(); ++i) {
+                auto expected = tape.evaluate(channels[i]);
+                test_uncertain(results[i], expected.mean(), expected.sd(), 7);
+            }
+        }
+        REQUIRE(shared.allocations > 0);
+    }
+    SECTION("No Outputs") {
+        std::vector<typename tape_t::variable_t> outputs;
+        REQUIRE(sigma::evaluate(tape, outputs).empty());
+    }
+}
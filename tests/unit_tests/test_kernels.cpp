@@ -0,0 +1,95 @@
+#include "testing.hpp"
+#include <cmath>
+#include <sigma/sigma.hpp>
+#include <vector>
+
+namespace {
+
+/// Checks a kernel against the function and a numeric derivative of it
+template<typename Kernel, typename Function>
+void check_kernel(Kernel kernel, Function f, double x) {
+    auto [value, deriv] = kernel(x);
+    auto step           = 1.0e-6;
+    auto numeric        = (f(x + step) - f(x - step)) / (2 * step);
+    REQUIRE(value == Catch::Approx(f(x)));
+    REQUIRE(deriv == Catch::Approx(numeric).epsilon(1.0e-6));
+}
+
+} // namespace
+
+TEST_CASE("Kernels") {
+    namespace k = sigma::kernels;
+    check_kernel(k::Sin{}, [](double x) { return std::sin(x); }, 0.3);
+    check_kernel(k::Cos{}, [](double x) { return std::cos(x); }, 0.3);
+    check_kernel(k::Tan{}, [](double x) { return std::tan(x); }, 0.3);
+    check_kernel(k::Asin{}, [](double x) { return std::asin(x); }, 0.3);
+    check_kernel(k::Acos{}, [](double x) { return std::acos(x); }, 0.3);
+    check_kernel(k::Atan{}, [](double x) { return std::atan(x); }, 0.3);
+    check_kernel(k::Sinh{}, [](double x) { return std::sinh(x); }, 0.3);
+    check_kernel(k::Cosh{}, [](double x) { return std::cosh(x); }, 0.3);
+    check_kernel(k::Tanh{}, [](double x) { return std::tanh(x); }, 0.3);
+    check_kernel(k::Asinh{}, [](double x) { return std::asinh(x); }, 0.3);
+    check_kernel(k::Acosh{}, [](double x) { return std::acosh(x); }, 1.3);
+    check_kernel(k::Atanh{}, [](double x) { return std::atanh(x); }, 0.3);
+    check_kernel(k::Sqrt{}, [](double x) { return std::sqrt(x); }, 0.3);
+    check_kernel(k::Cbrt{}, [](double x) { return std::cbrt(x); }, 0.3);
+    check_kernel(k::Exp{}, [](double x) { return std::exp(x); }, 0.3);
+    check_kernel(k::Exp2{}, [](double x) { return std::exp2(x); }, 0.3);
+    check_kernel(k::Expm1{}, [](double x) { return std::expm1(x); }, 0.3);
+    check_kernel(k::Log{}, [](double x) { return std::log(x); }, 0.3);
+    check_kernel(k::Log10{}, [](double x) { return std::log10(x); }, 0.3);
+    check_kernel(k::Log2{}, [](double x) { return std::log2(x); }, 0.3);
+    check_kernel(k::Log1p{}, [](double x) { return std::log1p(x); }, 0.3);
+    check_kernel(k::Erf{}, [](double x) { return std::erf(x); }, 0.3);
+    check_kernel(k::Erfc{}, [](double x) { return std::erfc(x); }, 0.3);
+    check_kernel(k::Tgamma{}, [](double x) { return std::tgamma(x); }, 0.3);
+    check_kernel(k::Tgamma{}, [](double x) { return std::tgamma(x); }, -1.3);
+    check_kernel(k::Lgamma{}, [](double x) { return std::lgamma(x); }, 0.3);
+    check_kernel(k::Lgamma{}, [](double x) { return std::lgamma(x); }, 42.0);
+
+    auto digamma = [](double x) { return sigma::detail_::digamma(x); };
+    check_kernel(k::Digamma{}, digamma, 0.3);
+    check_kernel(k::Digamma{}, digamma, -2.7);
+    check_kernel(k::Digamma{}, digamma, 15.0);
+    REQUIRE(digamma(1.0) == Catch::Approx(-0.5772156649015329));
+    REQUIRE(digamma(0.5) == Catch::Approx(-1.9635100260214235));
+}
+
+TEST_CASE("Binary Kernels") {
+    namespace k = sigma::kernels;
+    auto [value, lhs, rhs] = k::Beta{}(2.0, 3.0);
+    REQUIRE(value == Catch::Approx(1.0 / 12.0));
+    REQUIRE(lhs == Catch::Approx(-13.0 / 144.0));
+    REQUIRE(rhs == Catch::Approx(-7.0 / 144.0));
+
+    auto [lvalue, llhs, lrhs] = k::Lbeta{}(2.0, 3.0);
+    REQUIRE(lvalue == Catch::Approx(std::log(1.0 / 12.0)));
+    REQUIRE(llhs == Catch::Approx(-13.0 / 12.0));
+    REQUIRE(lrhs == Catch::Approx(-7.0 / 12.0));
+}
+
+TEMPLATE_TEST_CASE("Transform", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    std::vector<testing_t> x{testing_t(0.1, 0.01), testing_t(0.2, 0.02),
+                             testing_t(0.3, 0.03)};
+
+    SECTION("Matches the unary operations") {
+        auto y = sigma::transform(x, sigma::kernels::Exp{});
+        REQUIRE(y.size() == x.size());
+        for(std::size_t i = 0; i < x.size(); ++i) {
+            REQUIRE(y[i] == sigma::exp(x[i]));
+        }
+    }
+    SECTION("In place") {
+        auto copy = x;
+        auto y    = sigma::transform(std::move(copy), sigma::kernels::Tanh{});
+        for(std::size_t i = 0; i < x.size(); ++i) {
+            REQUIRE(y[i] == sigma::tanh(x[i]));
+        }
+    }
+    SECTION("Empty") {
+        std::vector<testing_t> none;
+        REQUIRE(sigma::transform(none, sigma::kernels::Sin{}).empty());
+    }
+}
@@ -0,0 +1,38 @@
+#include "testing.hpp"
+#include <cmath>
+#include <sigma/sigma.hpp>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Lift", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+
+    SECTION("Matches the operations") {
+        auto f = sigma::lift([](auto x, auto y) {
+            using std::exp;
+            using std::sin;
+            return x * exp(-y) + sin(x) / y;
+        });
+        auto lifted = f(a, b);
+        auto eager  = a * sigma::exp(-b) + sigma::sin(a) / b;
+        test_uncertain(lifted, eager.mean(), eager.sd(), 2);
+    }
+    SECTION("Repeated Variable") {
+        auto square = sigma::lift([](auto x, auto y) { return x * y; });
+        test_uncertain(square(a, a), 1.0, 0.2, 1);
+    }
+    SECTION("Plain Numbers") {
+        auto f = sigma::lift([](auto x, auto y, auto z) { return x * y + z; });
+        test_uncertain(f(a, 3.0, b), 5.0, 0.3606, 2);
+        test_uncertain(f(2.0, 3.0, b), 8.0, 0.2, 1);
+    }
+    SECTION("Branches") {
+        auto ramp =
+          sigma::lift([](auto x) { return x > 1.5 ? x - 1.5 : 0 * x; });
+        test_uncertain(ramp(b), 0.5, 0.2, 1);
+        test_uncertain(ramp(a), 0.0, 0.0, 0);
+    }
+}
@@ -0,0 +1,63 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+#include <vector>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Memoization", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+    using deps_t    = typename testing_t::deps_map_t;
+
+    // Enough sources for the dependencies to be stored on the heap
+    std::vector<testing_t> sources;
+    for(int i = 0; i < 8; ++i) sources.emplace_back(1.0 + i, 0.1);
+    testing_t a = sigma::sum(std::vector(sources.begin(), sources.begin() + 6));
+    testing_t b = sigma::sum(std::vector(sources.begin() + 2, sources.end()));
+    testing_t c(2.0, 0.2);
+    auto expected = a * b;
+
+    SECTION("Off by default") {
+        REQUIRE(sigma::detail_::thread_memo_cache<deps_t>() == nullptr);
+    }
+    SECTION("Repeated operations are cached") {
+        sigma::ScopedMemo<testing_t> memo(16);
+        auto x = a * b;
+        auto y = a * b;
+        REQUIRE(memo.cache().hits() == 1);
+        REQUIRE(memo.cache().misses() == 1);
+        REQUIRE(x == expected);
+        REQUIRE(y == expected);
+        REQUIRE(y.deps().block() == x.deps().block());
+    }
+    SECTION("Different operations are not confused") {
+        sigma::ScopedMemo<testing_t> memo(16);
+        auto x = a * b;
+        auto y = a + b;
+        auto z = b * a;
+        REQUIRE(memo.cache().hits() == 0);
+        auto sum = a;
+        sum += b;
+        REQUIRE(y == sum);
+        REQUIRE(z.deps() == x.deps());
+        test_uncertain(a - a, 0.0, 0.0, 0);
+    }
+    SECTION("Inline operands are not cached") {
+        sigma::ScopedMemo<testing_t> memo(16);
+        auto x = c * c;
+        test_uncertain(x, 4.0, 0.8, 1);
+        REQUIRE(memo.cache().hits() + memo.cache().misses() == 0);
+    }
+    SECTION("Scopes") {
+        {
+            sigma::ScopedMemo<testing_t> outer(16);
+            {
+                sigma::ScopedMemo<testing_t> inner(16);
+                REQUIRE(sigma::detail_::thread_memo_cache<deps_t>() ==
+                        &inner.cache());
+            }
+            REQUIRE(sigma::detail_::thread_memo_cache<deps_t>() ==
+                    &outer.cache());
+        }
+        REQUIRE(sigma::detail_::thread_memo_cache<deps_t>() == nullptr);
+    }
+}
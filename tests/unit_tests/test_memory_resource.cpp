@@ -0,0 +1,86 @@
+#include "testing.hpp"
+#include <cstddef>
+#include <memory_resource>
+#include <sigma/sigma.hpp>
+
+using testing::test_uncertain;
+
+namespace {
+
+/// Forwards to the default resource, counting the allocations made
+class CountingResource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    void do_deallocate(void* p, std::size_t bytes,
+                       std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+TEMPLATE_TEST_CASE("Memory Resource", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto* default_resource = std::pmr::get_default_resource();
+
+    SECTION("Default") {
+        REQUIRE(sigma::get_memory_resource() == default_resource);
+    }
+    SECTION("Set and restore") {
+        CountingResource resource;
+        auto* previous = sigma::set_memory_resource(&resource);
+        REQUIRE(previous == nullptr);
+        REQUIRE(sigma::get_memory_resource() == &resource);
+        sigma::set_memory_resource(nullptr);
+        REQUIRE(sigma::get_memory_resource() == default_resource);
+    }
+    SECTION("Scoped") {
+        CountingResource outer, inner;
+        {
+            sigma::ScopedMemoryResource outer_scope(&outer);
+            {
+                sigma::ScopedMemoryResource inner_scope(&inner);
+                REQUIRE(sigma::get_memory_resource() == &inner);
+            }
+            REQUIRE(sigma::get_memory_resource() == &outer);
+        }
+        REQUIRE(sigma::get_memory_resource() == default_resource);
+    }
+    SECTION("Scope restores the default, not a snapshot of it") {
+        CountingResource scoped, new_default;
+        { sigma::ScopedMemoryResource scope(&scoped); }
+        auto* old_default = std::pmr::set_default_resource(&new_default);
+        REQUIRE(sigma::get_memory_resource() == &new_default);
+        std::pmr::set_default_resource(old_default);
+    }
+    SECTION("Dependencies are allocated from the resource") {
+        CountingResource resource;
+        sigma::ScopedMemoryResource scope(&resource);
+        testing_t sum;
+        for(std::size_t i = 0; i <= testing_t::deps_map_t::inline_size; ++i) {
+            sum += testing_t(1.0, 0.1);
+        }
+        REQUIRE(resource.allocations > 0);
+        REQUIRE(sum.deps().size() == testing_t::deps_map_t::inline_size + 1);
+    }
+    SECTION("Arena") {
+        std::pmr::monotonic_buffer_resource arena;
+        sigma::ScopedMemoryResource scope(&arena);
+        auto a = testing_t(1.0, 0.1);
+        auto b = testing_t(2.0, 0.2);
+        auto c = testing_t(3.0, 0.3);
+        auto d = testing_t(4.0, 0.4);
+        auto e = testing_t(5.0, 0.5);
+        test_uncertain(a + b + c + d + e, 15.0, 0.7416, 5);
+    }
+}
@@ -0,0 +1,47 @@
+#include "testing.hpp"
+#include <cmath>
+#include <sigma/sigma.hpp>
+#include <stdexcept>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Find Root", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(2.0, 0.1);
+    auto b = testing_t(1.0, 0.1);
+
+    SECTION("Matches the operations") {
+        auto root = sigma::find_root([](auto x, auto p) { return x * x - p; },
+                                     1.0, a);
+        auto eager = sigma::sqrt(a);
+        test_uncertain(root, eager.mean(), eager.sd(), 1);
+    }
+    SECTION("Transcendental") {
+        auto lambert_w = [](auto x, auto p) {
+            using std::exp;
+            return x * exp(x) - p;
+        };
+        test_uncertain(sigma::find_root(lambert_w, 0.0, b), 0.5671, 0.0362,
+                       1);
+    }
+    SECTION("Several Parameters") {
+        auto f = [](auto x, auto p, auto q, auto r) {
+            return p * x * x + q * x - r;
+        };
+        // x^2 + 3x - 10 = 0 has the roots 2 and -5
+        auto root = sigma::find_root(f, 1.0, b, 3.0, testing_t(10.0, 0.5));
+        test_uncertain(root, 2.0, 0.0915, 2);
+        auto other = sigma::find_root(f, -10.0, b, 3.0, testing_t(10.0, 0.5));
+        REQUIRE(other.mean() == Catch::Approx(-5.0));
+    }
+    SECTION("Flat at the Root") {
+        // Starting on the double root, where the derivative vanishes
+        auto f = [](auto x, auto p) { return (x - p) * (x - p); };
+        REQUIRE_THROWS_AS(sigma::find_root(f, 2.0, a), std::runtime_error);
+    }
+    SECTION("No Root") {
+        auto f = [](auto x, auto p) { return x * x + p; };
+        REQUIRE_THROWS_AS(sigma::find_root(f, 1.0, a), std::runtime_error);
+    }
+}
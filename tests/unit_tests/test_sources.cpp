@@ -0,0 +1,47 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Scoped Sources", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t  = TestType;
+    using registry_t = typename testing_t::registry_t;
+
+    auto& registry = registry_t::instance();
+
+    SECTION("Collects the sources created in the scope") {
+        sigma::ScopedSources<testing_t> sources;
+        auto a = testing_t(1.0, 0.1);
+        auto b = testing_t(2.0, 0.2);
+        test_uncertain(a + b, 3.0, 0.2236, 2);
+        REQUIRE(sources.size() == 2);
+    }
+    SECTION("Nested scopes") {
+        sigma::ScopedSources<testing_t> outer;
+        auto a = testing_t(1.0, 0.1);
+        {
+            sigma::ScopedSources<testing_t> inner;
+            auto b = testing_t(2.0, 0.2);
+            REQUIRE(inner.size() == 1);
+        }
+        auto c = testing_t(3.0, 0.3);
+        REQUIRE(outer.size() == 2);
+        test_uncertain(a + c, 4.0, 0.3162, 2);
+    }
+    SECTION("Memory stays bounded across batches") {
+        auto batch = [](double scale) {
+            sigma::ScopedSources<testing_t> sources;
+            testing_t sum(0.0);
+            for(int i = 0; i < 2000; ++i) sum += testing_t(scale, 0.1 * scale);
+            return std::pair{sum.mean(), sum.sd()};
+        };
+        batch(1.0);
+        auto size = registry.size();
+        for(int i = 1; i <= 10; ++i) {
+            auto [mean, sd] = batch(i);
+            REQUIRE(mean == Catch::Approx(2000.0 * i));
+            REQUIRE(sd == Catch::Approx(0.1 * i * std::sqrt(2000.0)));
+        }
+        REQUIRE(registry.size() == size);
+    }
+}
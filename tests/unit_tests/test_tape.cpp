@@ -0,0 +1,124 @@
+#include "testing.hpp"
+#include <sigma/sigma.hpp>
+
+using testing::test_uncertain;
+
+TEMPLATE_TEST_CASE("Tape", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+    auto c = testing_t(3.0, 0.3);
+
+    sigma::Tape<testing_t> tape;
+    auto x = tape.variable(a);
+    auto y = tape.variable(b);
+    auto z = tape.variable(c);
+    REQUIRE(tape.size() == 3);
+
+    SECTION("Input") {
+        testing_t result = tape.evaluate(x);
+        REQUIRE(result == a);
+    }
+    SECTION("Arithmetic") {
+        test_uncertain(tape.evaluate(x + y), 3.0, 0.2236, 2);
+        test_uncertain(tape.evaluate(x - y), -1.0, 0.2236, 2);
+        test_uncertain(tape.evaluate(x * y), 2.0, 0.2828, 2);
+        test_uncertain(tape.evaluate(x / y), 0.5, 0.0707, 2);
+        test_uncertain(tape.evaluate(-x), -1.0, 0.1, 1);
+    }
+    SECTION("With Plain Numbers") {
+        test_uncertain(tape.evaluate(2.0 * x + 1.0), 3.0, 0.2, 1);
+        test_uncertain(tape.evaluate(1.0 / (y - 4.0)), -0.5, 0.05, 1);
+        test_uncertain(tape.evaluate(1.0 - x), 0.0, 0.1, 1);
+        auto w = x;
+        w *= 3.0;
+        w -= y;
+        test_uncertain(tape.evaluate(w), 1.0, 0.3606, 2);
+    }
+    SECTION("Cancellation") {
+        test_uncertain(tape.evaluate(x - x), 0.0, 0.0, 0);
+        test_uncertain(tape.evaluate(x * x), 1.0, 0.2, 1);
+    }
+    SECTION("Matches eager evaluation") {
+        auto taped = tape.evaluate(x * sin(y) + exp(z / x) - pow(y, 2));
+        auto eager = a * sigma::sin(b) + sigma::exp(c / a) - sigma::pow(b, 2);
+        test_uncertain(taped, eager.mean(), eager.sd(), 3);
+        for(const auto& [source, deriv] : eager.deps()) {
+            REQUIRE(taped.deps().find(source)->second == Catch::Approx(deriv));
+        }
+    }
+    SECTION("Several Outputs") {
+        auto u = x * y;
+        auto v = u + z;
+        test_uncertain(tape.evaluate(u), 2.0, 0.2828, 2);
+        test_uncertain(tape.evaluate(v), 5.0, 0.4123, 3);
+    }
+    SECTION("Long Computation") {
+        auto w = x;
+        for(int i = 0; i < 1000; ++i) w = w * 0.999 + y * 0.001;
+        auto eager = a;
+        for(int i = 0; i < 1000; ++i) eager = eager * 0.999 + b * 0.001;
+        test_uncertain(tape.evaluate(w), eager.mean(), eager.sd(), 2);
+        REQUIRE(tape.size() == 3 + 3000);
+    }
+    SECTION("Comparisons") {
+        REQUIRE(x < y);
+        REQUIRE(y > 1.0);
+        REQUIRE(x == 1.0);
+    }
+    SECTION("Clear") {
+        tape.clear();
+        REQUIRE(tape.size() == 0);
+    }
+}
+
+TEMPLATE_TEST_CASE("Tape Updates", "", sigma::UFloat, sigma::UDouble) {
+    using testing_t = TestType;
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+    auto c = testing_t(3.0, 0.3);
+
+    sigma::Tape<testing_t> tape(true);
+    auto x = tape.variable(a);
+    auto y = tape.variable(b);
+    auto z = tape.variable(c);
+    auto u = x * sin(y) + exp(z / x) - pow(y, 2);
+    auto v = 2.0 / (z - 1.0);
+    REQUIRE(tape.updatable());
+
+    SECTION("Only dependent records change") {
+        tape.set_mean(x, 1.5);
+        REQUIRE(tape.changed(x));
+        REQUIRE(tape.changed(u));
+        REQUIRE_FALSE(tape.changed(y));
+        REQUIRE_FALSE(tape.changed(v));
+        REQUIRE(x.value() == Catch::Approx(1.5));
+        REQUIRE(v.value() == Catch::Approx(1.0));
+    }
+    SECTION("Matches recording again") {
+        tape.set_mean(x, 1.5);
+        tape.set_mean(z, 2.5);
+        auto a2    = testing_t(1.5, 0.1);
+        auto c2    = testing_t(2.5, 0.3);
+        auto eager = a2 * sigma::sin(b) + sigma::exp(c2 / a2) -
+                     sigma::pow(b, 2);
+        auto updated = tape.evaluate(u);
+        test_uncertain(updated, eager.mean(), eager.sd(), 3);
+        test_uncertain(tape.evaluate(v), 4.0 / 3.0, 0.2667, 1);
+        REQUIRE(tape.changed(v));
+        REQUIRE_FALSE(tape.changed(x));
+    }
+    SECTION("Records after an update use the new values") {
+        tape.set_mean(y, 3.0);
+        test_uncertain(tape.evaluate(x * y), 3.0, 0.3606, 2);
+    }
+    SECTION("Errors") {
+        REQUIRE_THROWS_AS(tape.set_mean(u, 1.0), std::invalid_argument);
+        sigma::Tape<testing_t> fixed;
+        auto w = fixed.variable(a);
+        REQUIRE_THROWS_AS(fixed.set_mean(w, 1.0), std::logic_error);
+        REQUIRE_FALSE(fixed.changed(w));
+    }
+}
@@ -1,6 +1,8 @@
 #include "testing.hpp"
 #include <sigma/sigma.hpp>
+#include <cstdint>
 #include <sstream>
+#include <stdexcept>
 
 using testing::test_uncertain;
 
@@ -114,4 +116,129 @@ TEMPLATE_TEST_CASE("Uncertain", "", sigma::UFloat, sigma::UDouble) {
             }
         }
     }
+
+    SECTION("set_source_sd") {
+        testing_t a(1.0, 0.1);
+        testing_t b(2.0, 0.2);
+        auto copy = a;
+        auto c    = a * b + a;
+        test_uncertain(c, 3.0, 0.3606, 2);
+        sigma::set_source_sd(a, value_t(0.2));
+        test_uncertain(a, 1.0, 0.2, 1);
+        test_uncertain(copy, 1.0, 0.2, 1);
+        test_uncertain(c, 3.0, 0.6325, 2);
+        REQUIRE_THROWS_AS(sigma::set_source_sd(c, value_t(0.1)),
+                          std::invalid_argument);
+        REQUIRE_THROWS_AS(sigma::set_source_sd(a * 2.0, value_t(0.1)),
+                          std::invalid_argument);
+    }
+}
+
+TEMPLATE_TEST_CASE("FixedUncertain", "", float, double) {
+    using value_t   = TestType;
+    using testing_t = sigma::FixedUncertain<value_t, 3>;
+
+    auto a = testing_t(1.0, 0.1, 0);
+    auto b = testing_t(2.0, 0.2, 1);
+
+    SECTION("Constructors") {
+        SECTION("Default") { test_uncertain(testing_t(), 0.0, 0.0, 0); }
+        SECTION("With Value") { test_uncertain(testing_t(1.0), 1.0, 0.0, 0); }
+        SECTION("With Mean, SD and Source") {
+            test_uncertain(a, 1.0, 0.1, 1);
+            REQUIRE(a.deps().gradient()[0] == value_t(0.1));
+            REQUIRE(testing_t::dep_sd(0) == 1.0);
+        }
+        SECTION("Source out of range") {
+            REQUIRE_THROWS_AS(testing_t(1.0, 0.1, 3), std::out_of_range);
+        }
+    }
+    SECTION("Sources are shared by slot") {
+        auto c = testing_t(1.5, 0.1, 0);
+        test_uncertain(c - a, 0.5, 0.0, 0);
+        REQUIRE(a == testing_t(1.0, 0.1, 0));
+        REQUIRE(a != testing_t(1.0, 0.1, 2));
+    }
+    SECTION("Operations") {
+        test_uncertain(a + b, 3.0, 0.2236, 2);
+        test_uncertain(a * b, 2.0, 0.2828, 2);
+        test_uncertain((a + b) / 2.0, 1.5, 0.1118, 2);
+        test_uncertain(sigma::sin(a), 0.8415, 0.0540, 1);
+        test_uncertain(sigma::pow(b, 2.0), 4.0, 0.8, 1);
+        test_uncertain(sigma::hypot(a, b), 2.2361, 0.1844, 2);
+        test_uncertain(sigma::abs(-a), 1.0, 0.1, 1);
+    }
+}
+
+TEMPLATE_TEST_CASE("AdaptiveUncertain", "", float, double) {
+    using testing_t = sigma::AdaptiveUncertain<TestType>;
+
+    testing_t sum;
+    for(std::size_t i = 0; i < 100; ++i) sum += testing_t(1.0, 0.1);
+
+    REQUIRE(sum.deps().is_dense());
+    test_uncertain(sum, 100.0, 1.0, 100);
+    test_uncertain(sum * 2.0 + testing_t(1.0, 0.1), 201.0, 2.0025, 101);
+    test_uncertain(sum - sum, 0.0, 0.0, 0);
+}
+
+TEMPLATE_TEST_CASE("HashedUncertain", "", float, double) {
+    using testing_t = sigma::HashedUncertain<TestType>;
+
+    testing_t sum(0.0);
+    for(std::size_t i = 0; i < 400; ++i) sum += testing_t(1.0, 0.1);
+
+    REQUIRE(sum.deps().is_hashed());
+    test_uncertain(sum, 400.0, 2.0, 400);
+    test_uncertain(sum * 2.0 + testing_t(1.0, 0.1), 801.0, 4.0012, 401);
+    test_uncertain(sum - sum, 0.0, 0.0, 0);
+}
+
+TEST_CASE("CompactUncertain") {
+    using testing_t = sigma::CompactUncertain<double>;
+    using deps_t    = typename testing_t::deps_map_t;
+
+    REQUIRE(sizeof(typename deps_t::value_type) == 8);
+
+    auto a = testing_t(1.0, 0.1);
+    auto b = testing_t(2.0, 0.2);
+    auto c = testing_t(3.0, 0.3);
+
+    auto x = sigma::exp(a * b) / sigma::sqrt(c) - sigma::sin(a + c);
+    test_uncertain(x, 5.0229, 1.2538, 3);
+    test_uncertain(a + b, 3.0, 0.2236, 2);
+    test_uncertain(a * b, 2.0, 0.2828, 2);
+    test_uncertain(a - a, 0.0, 0.0, 0);
+
+    SECTION("Agrees with full precision") {
+        auto ad = sigma::UDouble(1.0, 0.1);
+        auto bd = sigma::UDouble(2.0, 0.2);
+        auto cd = sigma::UDouble(3.0, 0.3);
+        auto xd = sigma::exp(ad * bd) / sigma::sqrt(cd) - sigma::sin(ad + cd);
+        REQUIRE(x.mean() == xd.mean());
+        REQUIRE(x.sd() == Catch::Approx(xd.sd()).epsilon(1.0e-6));
+    }
+}
+
+TEST_CASE("Source IDs per ID type") {
+    using compact_t = sigma::CompactUncertain<double>;
+    using narrow_t =
+      sigma::Uncertain<float, sigma::detail_::DepsMap<std::uint16_t, float>>;
+
+    SECTION("Wide IDs do not use up narrow ones") {
+        auto& registry = compact_t::registry_t::instance();
+        auto size      = registry.size();
+        for(int i = 0; i < 10; ++i) sigma::UDouble(1.0, 0.1);
+        REQUIRE(registry.size() == size);
+    }
+    SECTION("Running out of IDs") {
+        auto& registry = narrow_t::registry_t::instance();
+        {
+            sigma::ScopedSources<narrow_t> sources;
+            for(std::size_t i = 0; i <= 0xFFFF; ++i) narrow_t(1.0, 0.1);
+            REQUIRE_THROWS_AS(narrow_t(1.0, 0.1), std::overflow_error);
+            REQUIRE(registry.size() == 0x10000);
+        }
+        test_uncertain(narrow_t(1.0, 0.1), 1.0, 0.1, 1);
+    }
 }